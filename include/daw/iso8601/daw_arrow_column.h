@@ -0,0 +1,277 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <daw/daw_string_view.h>
+
+#include "daw_date_parsing.h"
+
+// The Arrow C Data Interface ABI.  These definitions are specified to be
+// copied verbatim, guarded by ARROW_C_DATA_INTERFACE, so that they are
+// compatible with any other copy including the one in the Arrow library
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ArrowSchema {
+	// Array type description
+	const char *format;
+	const char *name;
+	const char *metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema **children;
+	struct ArrowSchema *dictionary;
+
+	// Release callback
+	void ( *release )( struct ArrowSchema * );
+	// Opaque producer-specific data
+	void *private_data;
+};
+
+struct ArrowArray {
+	// Array data description
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void **buffers;
+	struct ArrowArray **children;
+	struct ArrowArray *dictionary;
+
+	// Release callback
+	void ( *release )( struct ArrowArray * );
+	// Opaque producer-specific data
+	void *private_data;
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace daw::date_parsing {
+	struct invalid_arrow_array {};
+
+	namespace details {
+		template<typename Duration>
+		constexpr char const *arrow_timestamp_format( ) noexcept {
+			using period = typename Duration::period;
+			if constexpr( std::is_same_v<period, std::ratio<1>> ) {
+				return "tss:UTC";
+			} else if constexpr( std::is_same_v<period, std::milli> ) {
+				return "tsm:UTC";
+			} else if constexpr( std::is_same_v<period, std::micro> ) {
+				return "tsu:UTC";
+			} else {
+				static_assert( std::is_same_v<period, std::nano>,
+				               "Arrow timestamps are in s, ms, us or ns" );
+				return "tsn:UTC";
+			}
+		}
+
+		constexpr bool get_bit( std::uint8_t const *bitmap,
+		                        std::size_t const n ) noexcept {
+			return ( ( bitmap[n / 8U] >> ( n % 8U ) ) & 1U ) != 0;
+		}
+	} // namespace details
+
+	/// Parse the Arrow string column described by offsets[0, length] and data
+	/// into values[0, length) as a count of Duration since the epoch.
+	/// validity must hold ( length + 7 ) / 8 bytes and receives an Arrow
+	/// validity bitmap.  Rows that are null in the optional input_validity
+	/// bitmap or fail to parse are null with a value of 0
+	/// @return the null count of the result
+	template<typename Duration = std::chrono::milliseconds, typename Offset>
+	std::size_t parse_iso8601_column( Offset const *offsets, char const *data,
+	                                  std::size_t const length,
+	                                  std::int64_t *values, std::uint8_t *validity,
+	                                  std::uint8_t const *input_validity = nullptr ) {
+		static_assert( std::is_same_v<Offset, std::int32_t> or
+		                 std::is_same_v<Offset, std::int64_t>,
+		               "Arrow string offsets are int32_t or int64_t" );
+		std::size_t null_count = 0;
+		std::size_t n = 0;
+		// A full byte of the bitmap is accumulated in a register and stored once
+		while( n < length ) {
+			auto const last = n + 8U < length ? n + 8U : length;
+			std::uint8_t bits = 0;
+			for( std::size_t bit = 0; n < last; ++n, ++bit ) {
+				details::timestamp_fields fields{ };
+				bool const is_valid =
+				  ( input_validity == nullptr or details::get_bit( input_validity, n ) ) and
+				  details::try_parse_iso8601_timestamp(
+				    daw::string_view( data + offsets[n],
+				                      static_cast<std::size_t>( offsets[n + 1] -
+				                                                offsets[n] ) ),
+				    fields );
+				values[n] = is_valid ? details::to_epoch<Duration>( fields ) : 0;
+				bits |= static_cast<std::uint8_t>( static_cast<unsigned>( is_valid )
+				                                   << bit );
+				null_count += static_cast<std::size_t>( not is_valid );
+			}
+			validity[( n - 1U ) / 8U] = bits;
+		}
+		return null_count;
+	}
+
+	/// An owning int64 timestamp column with an Arrow validity bitmap
+	template<typename Duration = std::chrono::milliseconds>
+	struct timestamp_column {
+		using duration = Duration;
+
+		std::vector<std::int64_t> values{ };
+		std::vector<std::uint8_t> validity{ };
+		std::size_t null_count = 0;
+
+		timestamp_column( ) = default;
+
+		explicit timestamp_column( std::size_t const length )
+		  : values( length )
+		  , validity( ( length + 7U ) / 8U ) {}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return values.size( );
+		}
+
+		[[nodiscard]] bool is_valid( std::size_t const n ) const noexcept {
+			return details::get_bit( validity.data( ), n );
+		}
+
+		[[nodiscard]] std::chrono::time_point<std::chrono::system_clock, Duration>
+		operator[]( std::size_t const n ) const noexcept {
+			return std::chrono::time_point<std::chrono::system_clock, Duration>(
+			  Duration( values[n] ) );
+		}
+	};
+
+	template<typename Duration = std::chrono::milliseconds, typename Offset>
+	timestamp_column<Duration>
+	parse_iso8601_column( Offset const *offsets, char const *data,
+	                      std::size_t const length,
+	                      std::uint8_t const *input_validity = nullptr ) {
+		auto result = timestamp_column<Duration>( length );
+		result.null_count = parse_iso8601_column<Duration>(
+		  offsets, data, length, result.values.data( ), result.validity.data( ),
+		  input_validity );
+		return result;
+	}
+
+	/// Parse an imported Arrow utf8 ("u") or large_utf8 ("U") array
+	template<typename Duration = std::chrono::milliseconds>
+	timestamp_column<Duration> parse_iso8601_column( ArrowSchema const &schema,
+	                                                 ArrowArray const &array ) {
+		daw::exception::precondition_check<invalid_arrow_array>(
+		  schema.format != nullptr and array.n_buffers == 3 and
+		  array.offset == 0 );
+		auto const format = daw::string_view( schema.format );
+		auto const *input_validity =
+		  static_cast<std::uint8_t const *>( array.buffers[0] );
+		auto const *data = static_cast<char const *>( array.buffers[2] );
+		auto const length = static_cast<std::size_t>( array.length );
+		if( format == daw::string_view( "u" ) ) {
+			return parse_iso8601_column<Duration>(
+			  static_cast<std::int32_t const *>( array.buffers[1] ), data, length,
+			  input_validity );
+		}
+		daw::exception::precondition_check<invalid_arrow_array>(
+		  format == daw::string_view( "U" ) );
+		return parse_iso8601_column<Duration>(
+		  static_cast<std::int64_t const *>( array.buffers[1] ), data, length,
+		  input_validity );
+	}
+
+	namespace details {
+		template<typename Duration>
+		struct arrow_export_data {
+			timestamp_column<Duration> column;
+			void const *buffers[2];
+		};
+
+		inline void release_arrow_schema( ArrowSchema *schema ) {
+			delete static_cast<std::string *>( schema->private_data );
+			schema->release = nullptr;
+		}
+
+		template<typename Duration>
+		void release_arrow_array( ArrowArray *array ) {
+			delete static_cast<arrow_export_data<Duration> *>( array->private_data );
+			array->release = nullptr;
+		}
+	} // namespace details
+
+	/// Move column into the Arrow C Data Interface structures.  Ownership
+	/// passes to the consumer which must call the release callbacks
+	template<typename Duration>
+	void export_timestamp_column( timestamp_column<Duration> &&column,
+	                              ArrowArray *out_array, ArrowSchema *out_schema,
+	                              std::string name = { } ) {
+		auto *schema_name = new std::string( std::move( name ) );
+		*out_schema = ArrowSchema{ details::arrow_timestamp_format<Duration>( ),
+		                           schema_name->c_str( ),
+		                           nullptr,
+		                           ARROW_FLAG_NULLABLE,
+		                           0,
+		                           nullptr,
+		                           nullptr,
+		                           &details::release_arrow_schema,
+		                           schema_name };
+
+		auto *data = new details::arrow_export_data<Duration>{
+		  std::move( column ), { nullptr, nullptr } };
+		auto const null_count = data->column.null_count;
+		// The validity buffer may be omitted when there are no nulls
+		data->buffers[0] =
+		  null_count == 0 ? nullptr
+		                  : static_cast<void const *>( data->column.validity.data( ) );
+		data->buffers[1] = data->column.values.data( );
+		*out_array =
+		  ArrowArray{ static_cast<std::int64_t>( data->column.size( ) ),
+		              static_cast<std::int64_t>( null_count ),
+		              0,
+		              2,
+		              0,
+		              data->buffers,
+		              nullptr,
+		              nullptr,
+		              &details::release_arrow_array<Duration>,
+		              data };
+	}
+} // namespace daw::date_parsing
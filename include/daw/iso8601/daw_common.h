@@ -25,16 +25,45 @@
 #include <daw/daw_exception.h>
 #include <daw/daw_string_view.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
 struct invalid_iso8601_timestamp {};
 struct invalid_javascript_timestamp {};
+struct invalid_syslog_timestamp {};
+struct invalid_clf_timestamp {};
+struct invalid_http_date {};
+struct invalid_epoch_timestamp {};
+struct invalid_iso8601_duration {};
+struct invalid_iso8601_interval {};
 
 namespace daw {
 	struct insuffient_input {};
 
 	namespace details {
-		template<typename Result>
-		constexpr Result to_integer( char const c ) noexcept {
-			return static_cast<Result>( c - '0' );
+		// The code unit types the parsers accept
+		template<typename CharT>
+		inline constexpr bool is_char_type_v =
+		  std::is_same_v<CharT, char> or std::is_same_v<CharT, wchar_t> or
+#if defined( __cpp_char8_t )
+		  std::is_same_v<CharT, char8_t> or
+#endif
+		  std::is_same_v<CharT, char16_t> or std::is_same_v<CharT, char32_t>;
+
+		// The value of a code unit without sign extension, so that a wide code
+		// unit is never truncated into the ASCII range
+		template<typename CharT>
+		constexpr std::uint32_t code_unit( CharT const c ) noexcept {
+			return static_cast<std::uint32_t>(
+			  static_cast<std::make_unsigned_t<CharT>>( c ) );
+		}
+
+		template<typename Result, typename CharT>
+		constexpr Result to_integer( CharT const c ) noexcept {
+			return static_cast<Result>( c - static_cast<CharT>( '0' ) );
 		}
 
 		template<typename Result, size_t count, typename CharT,
@@ -89,12 +118,10 @@ namespace daw {
 			return static_cast<Result>( result );
 		}
 
-		constexpr bool is_digit( char const c ) noexcept {
-			return '0' <= c && c <= '9';
-		}
-
-		constexpr bool is_digit( wchar_t const c ) noexcept {
-			return L'0' <= c && c <= L'9';
+		template<typename CharT,
+		         std::enable_if_t<is_char_type_v<CharT>, std::nullptr_t> = nullptr>
+		constexpr bool is_digit( CharT const c ) noexcept {
+			return code_unit( c ) - static_cast<std::uint32_t>( '0' ) < 10U;
 		}
 
 		template<typename CharT, string_view_bounds_type Bounds>
@@ -103,12 +130,185 @@ namespace daw {
 			return !sv.empty( ) && is_digit( sv.front( ) );
 		}
 
-		constexpr char to_lower( char const c ) noexcept {
-			return static_cast<char>( c | ' ' );
+		template<typename CharT>
+		constexpr CharT to_lower( CharT const c ) noexcept {
+			return static_cast<CharT>( c | static_cast<CharT>( ' ' ) );
+		}
+
+		// The character type of a contiguous range of code units such as
+		// std::basic_string, std::basic_string_view, std::span or std::vector
+		template<typename Range, typename = void>
+		struct range_char_type {};
+
+		template<typename Range>
+		struct range_char_type<
+		  Range, std::void_t<decltype( std::data( std::declval<Range const &>( ) ) ),
+		                     decltype( std::size( std::declval<Range const &>( ) ) )>> {
+			using type = std::remove_cv_t<std::remove_pointer_t<decltype(
+			  std::data( std::declval<Range const &>( ) ) )>>;
+		};
+
+		template<typename Range, typename = void>
+		inline constexpr bool is_char_range_v = false;
+
+		template<typename Range>
+		inline constexpr bool is_char_range_v<
+		  Range, std::void_t<typename range_char_type<Range>::type>> =
+		  is_char_type_v<typename range_char_type<Range>::type>;
+
+		template<typename Range>
+		using enable_if_char_range =
+		  std::enable_if_t<is_char_range_v<Range>, std::nullptr_t>;
+
+		/// View a contiguous range of code units.  A character array ends at its
+		/// first nul, which drops the terminator of a string literal, or at its
+		/// extent when it is a filled buffer without one
+		template<typename Range>
+		constexpr auto to_string_view( Range const &str ) noexcept {
+			using char_t = typename range_char_type<Range>::type;
+			if constexpr( std::is_array_v<Range> ) {
+				std::size_t size = 0;
+				while( size < std::size( str ) && str[size] != char_t{ } ) {
+					++size;
+				}
+				return daw::basic_string_view<char_t>( std::data( str ), size );
+			} else {
+				return daw::basic_string_view<char_t>( std::data( str ),
+				                                       std::size( str ) );
+			}
+		}
+
+		// Days since 1970-01-01 of the proleptic Gregorian date y-m-d.  This is
+		// the same algorithm date::sys_days uses, without building the calendar
+		// types
+		constexpr std::int64_t days_from_civil( std::int32_t y, std::uint32_t m,
+		                                        std::uint32_t d ) noexcept {
+			y -= static_cast<std::int32_t>( m <= 2 );
+			auto const era = ( y >= 0 ? y : y - 399 ) / 400;
+			auto const yoe = static_cast<std::uint32_t>( y - era * 400 );
+			auto const doy = ( 153U * ( m > 2 ? m - 3 : m + 9 ) + 2U ) / 5U + d - 1U;
+			auto const doe = yoe * 365U + yoe / 4U - yoe / 100U + doy;
+			return static_cast<std::int64_t>( era ) * 146097 +
+			       static_cast<std::int64_t>( doe ) - 719468;
+		}
+
+		struct civil_date {
+			std::int32_t y;
+			std::uint32_t m;
+			std::uint32_t d;
+		};
+
+		// Inverse of days_from_civil
+		constexpr civil_date civil_from_days( std::int64_t z ) noexcept {
+			z += 719468;
+			auto const era = static_cast<std::int32_t>(
+			  ( z >= 0 ? z : z - 146096 ) / 146097 );
+			auto const doe = static_cast<std::uint32_t>(
+			  z - static_cast<std::int64_t>( era ) * 146097 );
+			auto const yoe =
+			  ( doe - doe / 1460U + doe / 36524U - doe / 146096U ) / 365U;
+			auto const doy = doe - ( 365U * yoe + yoe / 4U - yoe / 100U );
+			auto const mp = ( 5U * doy + 2U ) / 153U;
+			auto const d = doy - ( 153U * mp + 2U ) / 5U + 1U;
+			auto const m = mp < 10U ? mp + 3U : mp - 9U;
+			return civil_date{ static_cast<std::int32_t>( yoe ) + era * 400 +
+			                     static_cast<std::int32_t>( m <= 2U ),
+			                   m, d };
+		}
+
+		// Load 8 characters with the first in the low byte, independent of the
+		// endianness of the host.  Written out so that compilers merge it into a
+		// single load
+		constexpr std::uint64_t load_8chars( char const *ptr ) noexcept {
+			auto const byte = [ptr]( std::size_t const n ) {
+				return static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[n] ) )
+				       << ( 8U * n );
+			};
+			return byte( 0 ) | byte( 1 ) | byte( 2 ) | byte( 3 ) | byte( 4 ) |
+			       byte( 5 ) | byte( 6 ) | byte( 7 );
+		}
+
+		constexpr bool is_8digits( std::uint64_t const chunk ) noexcept {
+			return ( ( chunk & 0xF0F0'F0F0'F0F0'F0F0ULL ) |
+			         ( ( ( chunk + 0x0606'0606'0606'0606ULL ) & 0xF0F0'F0F0'F0F0'F0F0ULL ) >>
+			           4U ) ) == 0x3333'3333'3333'3333ULL;
+		}
+
+		// The value of 8 decimal digits, combining neighbouring digits, then
+		// pairs, then quads, in three multiplies
+		constexpr std::uint32_t parse_8digits( std::uint64_t chunk ) noexcept {
+			chunk -= 0x3030'3030'3030'3030ULL;
+			chunk = ( chunk * 10U ) + ( chunk >> 8U );
+			chunk = ( ( ( chunk & 0x0000'00FF'0000'00FFULL ) *
+			            ( 100U + ( 1'000'000ULL << 32U ) ) ) +
+			          ( ( ( chunk >> 16U ) & 0x0000'00FF'0000'00FFULL ) *
+			            ( 1U + ( 10'000ULL << 32U ) ) ) ) >>
+			        32U;
+			return static_cast<std::uint32_t>( chunk );
+		}
+
+		// Hint that the cache line holding ptr is about to be read
+		inline void prefetch( void const *ptr ) noexcept {
+#if defined( __GNUC__ ) || defined( __clang__ )
+			__builtin_prefetch( ptr, 0, 3 );
+#else
+			(void)ptr;
+#endif
+		}
+
+		// ISO weekday, Monday is 1 and Sunday is 7.  1970-01-01 was a Thursday
+		constexpr std::uint32_t iso_weekday( std::int64_t const days ) noexcept {
+			auto const wd = ( days + 3 ) % 7;
+			return static_cast<std::uint32_t>( wd < 0 ? wd + 7 : wd ) + 1U;
 		}
 
-		constexpr wchar_t to_lower( wchar_t const c ) noexcept {
-			return static_cast<wchar_t>( c | L' ' );
+		// Day 1-366 of the year of y-m-d
+		constexpr std::uint32_t day_of_year( std::int32_t const y,
+		                                     std::uint32_t const m,
+		                                     std::uint32_t const d ) noexcept {
+			constexpr std::uint16_t days_before_month[12] = {
+			  0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+			bool const is_leap = y % 4 == 0 && ( y % 100 != 0 || y % 400 == 0 );
+			return days_before_month[m - 1U] + d +
+			       static_cast<std::uint32_t>( is_leap && m > 2 );
+		}
+
+		// Days since the epoch of the Monday that starts ISO week 1 of year y,
+		// the week containing January 4th
+		constexpr std::int64_t iso_week1_monday( std::int32_t const y ) noexcept {
+			auto const jan4 = days_from_civil( y, 1, 4 );
+			return jan4 - static_cast<std::int64_t>( iso_weekday( jan4 ) ) + 1;
+		}
+
+		constexpr std::uint32_t iso_weeks_in_year( std::int32_t const y ) noexcept {
+			return static_cast<std::uint32_t>(
+			  ( iso_week1_monday( y + 1 ) - iso_week1_monday( y ) ) / 7 );
+		}
+
+		constexpr std::int64_t
+		days_from_iso_week_date( std::int32_t const y, std::uint32_t const week,
+		                         std::uint32_t const wd ) noexcept {
+			return iso_week1_monday( y ) +
+			       static_cast<std::int64_t>( ( week - 1U ) * 7U + wd - 1U );
+		}
+
+		struct iso_week_date {
+			std::int32_t y;
+			std::uint32_t week;
+			std::uint32_t wd;
+		};
+
+		// The ISO week based year is that of the Thursday in the same week
+		constexpr iso_week_date
+		iso_week_date_from_days( std::int64_t const days ) noexcept {
+			auto const wd = iso_weekday( days );
+			auto const thursday = days - static_cast<std::int64_t>( wd ) + 4;
+			auto const y = civil_from_days( thursday ).y;
+			return iso_week_date{
+			  y,
+			  static_cast<std::uint32_t>( ( thursday - days_from_civil( y, 1, 1 ) ) / 7 ) +
+			    1U,
+			  wd };
 		}
 	} // namespace details
 } // namespace daw
@@ -0,0 +1,239 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace daw::date_parsing {
+	namespace details {
+		constexpr std::uint32_t bit_width( std::uint64_t value ) noexcept {
+			std::uint32_t result = 0;
+			while( value != 0 ) {
+				value >>= 1U;
+				++result;
+			}
+			return result;
+		}
+
+		constexpr std::uint64_t low_bits_mask( std::uint32_t const width ) noexcept {
+			return width >= 64U ? ~std::uint64_t{ 0 }
+			                    : ( std::uint64_t{ 1 } << width ) - 1U;
+		}
+
+		// Read the width bit value at bit position pos.  Values may span two
+		// words
+		inline std::uint64_t read_packed( std::uint64_t const *words,
+		                                  std::size_t const pos,
+		                                  std::uint32_t const width ) noexcept {
+			auto const word = pos / 64U;
+			auto const shift = static_cast<std::uint32_t>( pos % 64U );
+			auto result = words[word] >> shift;
+			if( shift + width > 64U ) {
+				result |= words[word + 1U] << ( 64U - shift );
+			}
+			return result & low_bits_mask( width );
+		}
+
+		inline void write_packed( std::uint64_t *words, std::size_t const pos,
+		                          std::uint32_t const width,
+		                          std::uint64_t const value ) noexcept {
+			auto const word = pos / 64U;
+			auto const shift = static_cast<std::uint32_t>( pos % 64U );
+			words[word] |= value << shift;
+			if( shift + width > 64U ) {
+				words[word + 1U] |= value >> ( 64U - shift );
+			}
+		}
+	} // namespace details
+
+	/// An append only column of time points stored as blocks of block_size
+	/// values.  Each block keeps its first value and the differences between
+	/// neighbours, frame of reference encoded against the smallest difference
+	/// and bit packed at the width of the largest.  Timestamps from logs differ
+	/// by a few units, so a value takes around a byte.  Values are appended to
+	/// an open block that is encoded when it is full.  Random access decodes
+	/// the prefix of one block.  push_back and value_type allow
+	/// std::back_inserter( column ) to be the output of the batch parsers
+	template<typename Duration = std::chrono::milliseconds>
+	class compressed_timestamp_column {
+	public:
+		using duration = Duration;
+		using value_type =
+		  std::chrono::time_point<std::chrono::system_clock, Duration>;
+		using size_type = std::size_t;
+
+		static constexpr std::size_t block_size = 128;
+
+	private:
+		struct block_header {
+			std::int64_t first;
+			std::int64_t min_delta;
+			std::uint32_t word_offset;
+			std::uint32_t width;
+		};
+
+		std::vector<block_header> m_blocks{ };
+		std::vector<std::uint64_t> m_words{ };
+		std::array<std::int64_t, block_size> m_open{ };
+		std::size_t m_open_size = 0;
+
+		void encode_open_block( ) {
+			// Differences are computed modulo 2^64, so any pair of values fits
+			auto const delta_at = [&]( std::size_t const n ) {
+				return static_cast<std::uint64_t>( m_open[n] ) -
+				       static_cast<std::uint64_t>( m_open[n - 1U] );
+			};
+			auto min_delta = static_cast<std::int64_t>( delta_at( 1 ) );
+			auto max_delta = min_delta;
+			for( std::size_t n = 2; n < block_size; ++n ) {
+				auto const delta = static_cast<std::int64_t>( delta_at( n ) );
+				min_delta = delta < min_delta ? delta : min_delta;
+				max_delta = delta > max_delta ? delta : max_delta;
+			}
+			auto const width =
+			  details::bit_width( static_cast<std::uint64_t>( max_delta ) -
+			                      static_cast<std::uint64_t>( min_delta ) );
+			auto const word_offset = m_words.size( );
+			m_words.resize( word_offset +
+			                ( ( block_size - 1U ) * width + 63U ) / 64U );
+			if( width != 0 ) {
+				for( std::size_t n = 1; n < block_size; ++n ) {
+					details::write_packed(
+					  m_words.data( ) + word_offset, ( n - 1U ) * width, width,
+					  delta_at( n ) - static_cast<std::uint64_t>( min_delta ) );
+				}
+			}
+			m_blocks.push_back( block_header{
+			  m_open[0], min_delta, static_cast<std::uint32_t>( word_offset ),
+			  width } );
+			m_open_size = 0;
+		}
+
+	public:
+		compressed_timestamp_column( ) = default;
+
+		/// Append a count of Duration since the epoch
+		void push_back( std::int64_t const value ) {
+			m_open[m_open_size++] = value;
+			if( m_open_size == block_size ) {
+				encode_open_block( );
+			}
+		}
+
+		void push_back( value_type const &tp ) {
+			push_back( static_cast<std::int64_t>( tp.time_since_epoch( ).count( ) ) );
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_blocks.size( ) * block_size + m_open_size;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return size( ) == 0;
+		}
+
+		/// Number of blocks, including the open block when it is not empty
+		[[nodiscard]] std::size_t block_count( ) const noexcept {
+			return m_blocks.size( ) + static_cast<std::size_t>( m_open_size > 0 );
+		}
+
+		/// Bytes held by the encoded blocks and the open block
+		[[nodiscard]] std::size_t memory_usage( ) const noexcept {
+			return m_blocks.size( ) * sizeof( block_header ) +
+			       m_words.size( ) * sizeof( std::uint64_t ) + sizeof( m_open );
+		}
+
+		/// The count of Duration since the epoch of the value at n
+		[[nodiscard]] std::int64_t value( std::size_t const n ) const noexcept {
+			auto const block = n / block_size;
+			auto const index = n % block_size;
+			if( block == m_blocks.size( ) ) {
+				return m_open[index];
+			}
+			auto const &header = m_blocks[block];
+			auto const *words = m_words.data( ) + header.word_offset;
+			auto result = static_cast<std::uint64_t>( header.first ) +
+			              static_cast<std::uint64_t>( header.min_delta ) * index;
+			if( header.width != 0 ) {
+				for( std::size_t m = 0; m < index; ++m ) {
+					result += details::read_packed( words, m * header.width, header.width );
+				}
+			}
+			return static_cast<std::int64_t>( result );
+		}
+
+		[[nodiscard]] value_type operator[]( std::size_t const n ) const noexcept {
+			return value_type( Duration( value( n ) ) );
+		}
+
+		/// Decode block b into out, which has room for block_size values
+		/// @return the number of values in the block
+		std::size_t decode_block( std::size_t const b,
+		                          std::int64_t *out ) const noexcept {
+			if( b == m_blocks.size( ) ) {
+				for( std::size_t n = 0; n < m_open_size; ++n ) {
+					out[n] = m_open[n];
+				}
+				return m_open_size;
+			}
+			auto const &header = m_blocks[b];
+			auto const *words = m_words.data( ) + header.word_offset;
+			// Unpack, then a prefix sum, so the unpack loop has no dependency
+			// between iterations
+			std::uint64_t deltas[block_size - 1U]{ };
+			if( header.width != 0 ) {
+				for( std::size_t n = 0; n < block_size - 1U; ++n ) {
+					deltas[n] =
+					  details::read_packed( words, n * header.width, header.width );
+				}
+			}
+			auto current = static_cast<std::uint64_t>( header.first );
+			auto const min_delta = static_cast<std::uint64_t>( header.min_delta );
+			out[0] = header.first;
+			for( std::size_t n = 1; n < block_size; ++n ) {
+				current += min_delta + deltas[n - 1U];
+				out[n] = static_cast<std::int64_t>( current );
+			}
+			return block_size;
+		}
+
+		/// Decode every value
+		[[nodiscard]] std::vector<value_type> decode( ) const {
+			std::vector<value_type> result{ };
+			result.reserve( size( ) );
+			std::int64_t values[block_size];
+			for( std::size_t b = 0; b < block_count( ); ++b ) {
+				auto const count = decode_block( b, values );
+				for( std::size_t n = 0; n < count; ++n ) {
+					result.push_back( value_type( Duration( values[n] ) ) );
+				}
+			}
+			return result;
+		}
+	};
+} // namespace daw::date_parsing
@@ -0,0 +1,355 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined( DAW_ISO8601_HAS_ZLIB )
+#include <zlib.h>
+#endif
+#if defined( DAW_ISO8601_HAS_ZSTD )
+#include <zstd.h>
+#endif
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+
+#include "daw_file_ingest.h"
+#include "daw_incremental_parsing.h"
+
+/// Streaming decompression of gzip and zstd files for the line based
+/// parsers.  The file is decompressed a block at a time into reused buffers
+/// and each block is parsed as it is produced, so the decompressed text is
+/// never held whole.  The decoders are available when DAW_ISO8601_HAS_ZLIB
+/// or DAW_ISO8601_HAS_ZSTD is defined and the library is linked.  Any type
+/// with the members of gzip_decoder can be used as a Decoder
+namespace daw::date_parsing {
+	struct invalid_compressed_stream {};
+
+	struct decode_result {
+		std::size_t consumed = 0;
+		std::size_t produced = 0;
+	};
+
+#if defined( DAW_ISO8601_HAS_ZLIB )
+	/// gzip, including files of several concatenated members, and zlib streams
+	class gzip_decoder {
+		z_stream m_stream{ };
+		bool m_started = false;
+		bool m_finished = false;
+
+	public:
+		gzip_decoder( ) {
+			// 32 enables detection of the gzip or zlib header
+			daw::exception::precondition_check<invalid_compressed_stream>(
+			  inflateInit2( &m_stream, 15 + 32 ) == Z_OK );
+		}
+
+		gzip_decoder( gzip_decoder const & ) = delete;
+		gzip_decoder &operator=( gzip_decoder const & ) = delete;
+
+		~gzip_decoder( ) {
+			inflateEnd( &m_stream );
+		}
+
+		/// Decompress from in to out, stopping when either is exhausted
+		decode_result decode( char const *in, std::size_t const in_size, char *out,
+		                      std::size_t const out_size ) {
+			if( m_finished ) {
+				if( in_size == 0 ) {
+					return { };
+				}
+				// The start of the next member
+				daw::exception::precondition_check<invalid_compressed_stream>(
+				  inflateReset( &m_stream ) == Z_OK );
+				m_finished = false;
+			}
+			m_started = m_started or in_size > 0;
+			auto const avail_in = in_size < UINT_MAX ? in_size : UINT_MAX;
+			auto const avail_out = out_size < UINT_MAX ? out_size : UINT_MAX;
+			m_stream.next_in = reinterpret_cast<Bytef *>( const_cast<char *>( in ) );
+			m_stream.avail_in = static_cast<uInt>( avail_in );
+			m_stream.next_out = reinterpret_cast<Bytef *>( out );
+			m_stream.avail_out = static_cast<uInt>( avail_out );
+			auto const rc = inflate( &m_stream, Z_NO_FLUSH );
+			daw::exception::precondition_check<invalid_compressed_stream>(
+			  rc == Z_OK or rc == Z_STREAM_END or rc == Z_BUF_ERROR );
+			m_finished = rc == Z_STREAM_END;
+			return { avail_in - m_stream.avail_in, avail_out - m_stream.avail_out };
+		}
+
+		/// True when the input so far ends on a complete member
+		[[nodiscard]] bool at_end( ) const noexcept {
+			return not m_started or m_finished;
+		}
+	};
+#endif
+
+#if defined( DAW_ISO8601_HAS_ZSTD )
+	/// zstd, including files of several frames
+	class zstd_decoder {
+		ZSTD_DCtx *m_context = ZSTD_createDCtx( );
+		bool m_started = false;
+		bool m_finished = false;
+
+	public:
+		zstd_decoder( ) {
+			daw::exception::precondition_check<invalid_compressed_stream>(
+			  m_context != nullptr );
+		}
+
+		zstd_decoder( zstd_decoder const & ) = delete;
+		zstd_decoder &operator=( zstd_decoder const & ) = delete;
+
+		~zstd_decoder( ) {
+			ZSTD_freeDCtx( m_context );
+		}
+
+		decode_result decode( char const *in, std::size_t const in_size, char *out,
+		                      std::size_t const out_size ) {
+			if( m_finished and in_size == 0 ) {
+				// Without input the context would start waiting on a new frame
+				return { };
+			}
+			m_started = m_started or in_size > 0;
+			auto input = ZSTD_inBuffer{ in, in_size, 0 };
+			auto output = ZSTD_outBuffer{ out, out_size, 0 };
+			auto const rc = ZSTD_decompressStream( m_context, &output, &input );
+			daw::exception::precondition_check<invalid_compressed_stream>(
+			  not ZSTD_isError( rc ) );
+			// 0 once a frame is decoded and all of its output is flushed
+			m_finished = rc == 0;
+			return { input.pos, output.pos };
+		}
+
+		[[nodiscard]] bool at_end( ) const noexcept {
+			return not m_started or m_finished;
+		}
+	};
+#endif
+
+	struct decompress_options {
+		/// Decompressed bytes per block
+		std::size_t block_size = 256U * 1024U;
+		/// Blocks in the ring between the decompressing thread and the caller.
+		/// Only used when threaded
+		std::size_t block_count = 4;
+		/// Decompress on a separate thread while the caller parses
+		bool threaded = false;
+		/// How the compressed file is read
+		file_ingest_options input{ 256U * 1024U, 4 };
+	};
+
+	namespace details {
+		/// Pulls compressed chunks from a file_chunk_reader through a Decoder
+		template<typename Decoder>
+		class decompressor {
+			file_chunk_reader m_input;
+			daw::string_view m_pending{ };
+			bool m_input_done = false;
+			Decoder m_decoder{ };
+
+		public:
+			decompressor( std::string const &path, file_ingest_options const &options )
+			  : m_input( path, options ) {}
+
+			/// Fill out with up to size decompressed bytes
+			/// @return bytes written, fewer than size only at the end of the stream
+			std::size_t read( char *out, std::size_t const size ) {
+				std::size_t produced = 0;
+				while( produced < size ) {
+					if( m_pending.empty( ) and not m_input_done ) {
+						m_pending = m_input.next( );
+						m_input_done = m_pending.empty( );
+					}
+					auto const r = m_decoder.decode( m_pending.data( ), m_pending.size( ),
+					                                 out + produced, size - produced );
+					m_pending.remove_prefix( r.consumed );
+					produced += r.produced;
+					if( r.consumed == 0 and r.produced == 0 ) {
+						// No progress with input left is corrupt data, and without any it
+						// is the end of the file, which must end a member or frame
+						daw::exception::precondition_check<invalid_compressed_stream>(
+						  m_input_done and m_pending.empty( ) and m_decoder.at_end( ) );
+						break;
+					}
+				}
+				return produced;
+			}
+		};
+	} // namespace details
+
+	/// Decompresses a file in blocks.  Each block returned by next is valid
+	/// until the following call.  When threaded, the next blocks are
+	/// decompressed into a bounded ring while the caller works on the current
+	/// one.  Blocks end at arbitrary bytes, feed them to
+	/// incremental_timestamp_parser which carries a line split across blocks
+	template<typename Decoder>
+	class decompressing_reader {
+		details::decompressor<Decoder> m_decompressor;
+		std::size_t m_block_size;
+		std::size_t m_block_count;
+		std::vector<char> m_storage;
+		std::vector<std::size_t> m_sizes;
+		std::size_t m_next_block = 0;
+		bool m_holding = false;
+		bool m_threaded;
+		// Threaded state.  m_done is set by the decompressing thread after the
+		// last block, or with m_error on failure
+		std::mutex m_mutex{ };
+		std::condition_variable m_cv{ };
+		std::size_t m_filled = 0;
+		std::size_t m_released = 0;
+		bool m_done = false;
+		bool m_stop = false;
+		std::exception_ptr m_error{ };
+		std::thread m_worker{ };
+
+		[[nodiscard]] char *block( std::size_t const n ) noexcept {
+			return m_storage.data( ) + ( n % m_block_count ) * m_block_size;
+		}
+
+		void decompress_blocks( ) {
+			try {
+				for( std::size_t n = 0;; ++n ) {
+					{
+						auto lock = std::unique_lock<std::mutex>( m_mutex );
+						m_cv.wait( lock, [&] {
+							return m_stop or n - m_released < m_block_count;
+						} );
+						if( m_stop ) {
+							return;
+						}
+					}
+					auto const size = m_decompressor.read( block( n ), m_block_size );
+					{
+						auto const lock = std::lock_guard<std::mutex>( m_mutex );
+						if( size > 0 ) {
+							m_sizes[n % m_block_count] = size;
+							++m_filled;
+						}
+						m_done = size < m_block_size;
+					}
+					m_cv.notify_all( );
+					if( size < m_block_size ) {
+						return;
+					}
+				}
+			} catch( ... ) {
+				{
+					auto const lock = std::lock_guard<std::mutex>( m_mutex );
+					m_error = std::current_exception( );
+					m_done = true;
+				}
+				m_cv.notify_all( );
+			}
+		}
+
+	public:
+		explicit decompressing_reader( std::string const &path,
+		                               decompress_options const &options = { } )
+		  : m_decompressor( path, options.input )
+		  , m_block_size( options.block_size > 0 ? options.block_size : 1U )
+		  , m_block_count( options.threaded ? options.block_count : 1U )
+		  , m_threaded( options.threaded ) {
+			daw::exception::precondition_check<file_ingest_error>( m_block_count > 1 or
+			                                                       not m_threaded );
+			m_storage.resize( m_block_size * m_block_count );
+			m_sizes.resize( m_block_count );
+			if( m_threaded ) {
+				m_worker = std::thread( [this] { decompress_blocks( ); } );
+			}
+		}
+
+		decompressing_reader( decompressing_reader const & ) = delete;
+		decompressing_reader &operator=( decompressing_reader const & ) = delete;
+
+		~decompressing_reader( ) {
+			if( m_worker.joinable( ) ) {
+				{
+					auto const lock = std::lock_guard<std::mutex>( m_mutex );
+					m_stop = true;
+				}
+				m_cv.notify_all( );
+				m_worker.join( );
+			}
+		}
+
+		/// The next block of decompressed bytes, empty at the end of the stream
+		daw::string_view next( ) {
+			if( not m_threaded ) {
+				if( m_done ) {
+					return { };
+				}
+				auto const size = m_decompressor.read( block( 0 ), m_block_size );
+				m_done = size < m_block_size;
+				return daw::string_view( block( 0 ), size );
+			}
+			auto lock = std::unique_lock<std::mutex>( m_mutex );
+			if( m_holding ) {
+				m_holding = false;
+				++m_released;
+				m_cv.notify_all( );
+			}
+			m_cv.wait( lock, [&] { return m_done or m_filled > m_next_block; } );
+			if( m_filled == m_next_block ) {
+				if( m_error ) {
+					std::rethrow_exception( m_error );
+				}
+				return { };
+			}
+			auto const n = m_next_block++;
+			m_holding = true;
+			return daw::string_view( block( n ), m_sizes[n % m_block_count] );
+		}
+	};
+
+	/// Parse a compressed file of newline separated ISO 8601 timestamps,
+	/// calling handler( time_point ) for each in file order.  Lines that are
+	/// not timestamps are counted as errors
+	template<typename Decoder, typename Duration = std::chrono::milliseconds,
+	         typename Handler>
+	file_ingest_result
+	ingest_compressed_iso8601_file( std::string const &path, Handler &&handler,
+	                                decompress_options const &options = { } ) {
+		decompressing_reader<Decoder> reader( path, options );
+		auto parser = incremental_timestamp_parser<Duration>( );
+		file_ingest_result result{ };
+		for( auto chunk = reader.next( ); not chunk.empty( );
+		     chunk = reader.next( ) ) {
+			result.timestamp_count += parser.feed( chunk, handler );
+		}
+		result.timestamp_count += parser.finish( handler );
+		result.error_count = parser.error_count( );
+		return result;
+	}
+} // namespace daw::date_parsing
@@ -233,11 +233,18 @@ namespace daw::date_formatting {
 			locale_name_formats locale_name_format = locale_name_formats::full;
 
 			template<typename State>
-			void operator( )( State &state ) const {
+			constexpr void operator( )( State &state ) const {
+				auto const days = static_cast<date::sys_days>( state.ymd )
+				                    .time_since_epoch( )
+				                    .count( );
+				auto const yr = static_cast<int>(
+				  ::daw::details::iso_week_date_from_days( days ).y );
 				if( locale_name_format == locale_name_formats::full ) {
-					::daw::date_formatting::impl::localize( CharT{ }, state, "%G" );
+					::daw::date_formatting::impl::output_digits( CharT{ }, 4, state.oi,
+					                                             yr );
 				} else {
-					::daw::date_formatting::impl::localize( CharT{ }, state, "%g" );
+					::daw::date_formatting::impl::output_digits( CharT{ }, 2, state.oi,
+					                                             yr % 100 );
 				}
 			}
 		};
@@ -315,12 +322,10 @@ namespace daw::date_formatting {
 
 			template<typename State>
 			constexpr void operator( )( State &state ) const {
-				auto const jan1 = state.ymd.year( ) / 1 / 1;
-				auto diff = std::chrono::floor<date::days>(
-				              static_cast<date::sys_days>( state.ymd ) -
-				              static_cast<date::sys_days>( jan1 ) )
-				              .count( ) +
-				            1;
+				auto diff = static_cast<int>( ::daw::details::day_of_year(
+				  static_cast<int>( state.ymd.year( ) ),
+				  static_cast<unsigned>( state.ymd.month( ) ),
+				  static_cast<unsigned>( state.ymd.day( ) ) ) );
 				auto width =
 				  ::daw::date_formatting::impl::format_width( field_width, diff );
 				::daw::date_formatting::impl::output_digits(
@@ -590,12 +595,12 @@ namespace daw::date_formatting {
 				formats::Day<CharT>{ 2 }( state );
 				break;
 			case 'g':
-				formats::ISOWeekBasedYear<CharT>{ }( state );
-				break;
-			case 'G':
 				formats::ISOWeekBasedYear<CharT>{
 				  formats::locale_name_formats::abbreviated }( state );
 				break;
+			case 'G':
+				formats::ISOWeekBasedYear<CharT>{ }( state );
+				break;
 			case 'H':
 				default_width( current_width, 2 );
 				formats::Hour<CharT>{ current_width }( state );
@@ -729,6 +734,125 @@ namespace daw::date_formatting {
 		return ostr;
 	}
 
+	namespace impl {
+		constexpr void put_2digits( char *ptr, std::uint32_t const value ) noexcept {
+			ptr[0] = static_cast<char>( '0' + value / 10U );
+			ptr[1] = static_cast<char>( '0' + value % 10U );
+		}
+
+		constexpr void put_4digits( char *ptr, std::uint32_t const value ) noexcept {
+			put_2digits( ptr, value / 100U );
+			put_2digits( ptr + 2, value % 100U );
+		}
+
+		// Writes YYYY-MM-DDTHH:MM:SS to ptr[0, 19) using only integer arithmetic
+		// on the epoch seconds, years must be in [0, 9999]
+		constexpr void put_date_time( char *ptr, std::int64_t const secs ) noexcept {
+			auto days = secs / 86400;
+			auto sod = secs % 86400;
+			if( sod < 0 ) {
+				sod += 86400;
+				--days;
+			}
+			auto const ymd = daw::details::civil_from_days( days );
+			auto const s = static_cast<std::uint32_t>( sod );
+			put_4digits( ptr, static_cast<std::uint32_t>( ymd.y ) );
+			ptr[4] = '-';
+			put_2digits( ptr + 5, ymd.m );
+			ptr[7] = '-';
+			put_2digits( ptr + 8, ymd.d );
+			ptr[10] = 'T';
+			put_2digits( ptr + 11, s / 3600U );
+			ptr[13] = ':';
+			put_2digits( ptr + 14, ( s / 60U ) % 60U );
+			ptr[16] = ':';
+			put_2digits( ptr + 17, s % 60U );
+		}
+	} // namespace impl
+
+	/// Length of the Javascript flavour of ISO 8601, YYYY-MM-DDTHH:MM:SS.sssZ
+	inline constexpr std::size_t javascript_timestamp_size = 24;
+
+	/// Fixed layout formatter for the Javascript flavour of ISO 8601 timestamps.
+	/// This is the inverse of parse_javascript_timestamp and does not go
+	/// through the generic format string machinery
+	template<typename Duration, typename OutputIterator>
+	constexpr OutputIterator
+	fmt_javascript_timestamp( date::sys_time<Duration> const &tp,
+	                          OutputIterator oi ) {
+		auto const ms = std::chrono::floor<std::chrono::milliseconds>( tp )
+		                  .time_since_epoch( )
+		                  .count( );
+		auto secs = ms / 1000;
+		auto frac = ms % 1000;
+		if( frac < 0 ) {
+			frac += 1000;
+			--secs;
+		}
+		char buff[javascript_timestamp_size]{ };
+		impl::put_date_time( buff, secs );
+		buff[19] = '.';
+		buff[20] = static_cast<char>( '0' + frac / 100 );
+		impl::put_2digits( buff + 21, static_cast<std::uint32_t>( frac % 100 ) );
+		buff[23] = 'Z';
+		return impl::copy( buff, buff + javascript_timestamp_size, oi );
+	}
+
+	template<typename Duration>
+	std::string fmt_javascript_timestamp( date::sys_time<Duration> const &tp ) {
+		std::string result( javascript_timestamp_size, '\0' );
+		fmt_javascript_timestamp( tp, result.data( ) );
+		return result;
+	}
+
+	/// Length of an ISO 8601 ordinal date, YYYY-DDD
+	inline constexpr std::size_t iso8601_ordinal_date_size = 8;
+
+	/// Length of an ISO 8601 week date, YYYY-Www-D
+	inline constexpr std::size_t iso8601_week_date_size = 10;
+
+	/// Write the ordinal date, YYYY-DDD, of tp to out
+	template<typename Duration>
+	constexpr void fmt_iso8601_ordinal_date( date::sys_time<Duration> const &tp,
+	                                         char *out ) noexcept {
+		auto const ymd = ::daw::details::civil_from_days(
+		  std::chrono::floor<date::days>( tp ).time_since_epoch( ).count( ) );
+		auto const doy = ::daw::details::day_of_year( ymd.y, ymd.m, ymd.d );
+		impl::put_4digits( out, static_cast<std::uint32_t>( ymd.y ) );
+		out[4] = '-';
+		out[5] = static_cast<char>( '0' + doy / 100U );
+		impl::put_2digits( out + 6, doy % 100U );
+	}
+
+	template<typename Duration>
+	std::string fmt_iso8601_ordinal_date( date::sys_time<Duration> const &tp ) {
+		std::string result( iso8601_ordinal_date_size, '\0' );
+		fmt_iso8601_ordinal_date( tp, result.data( ) );
+		return result;
+	}
+
+	/// Write the week date, YYYY-Www-D, of tp to out.  The year is the ISO week
+	/// based year, which differs from the calendar year near January 1st
+	template<typename Duration>
+	constexpr void fmt_iso8601_week_date( date::sys_time<Duration> const &tp,
+	                                      char *out ) noexcept {
+		auto const wdate = ::daw::details::iso_week_date_from_days(
+		  std::chrono::floor<date::days>( tp ).time_since_epoch( ).count( ) );
+		impl::put_4digits( out, static_cast<std::uint32_t>( wdate.y ) );
+		out[4] = '-';
+		out[5] = 'W';
+		impl::put_2digits( out + 6, wdate.week );
+		out[8] = '-';
+		out[9] = static_cast<char>( '0' + wdate.wd );
+	}
+
+	template<typename Duration>
+	std::string fmt_iso8601_week_date( date::sys_time<Duration> const &tp ) {
+		std::string result( iso8601_week_date_size, '\0' );
+		fmt_iso8601_week_date( tp, result.data( ) );
+		return result;
+	}
+
 	template<typename Duration>
 	std::string strftime( daw::string_view format_str,
 	                      date::sys_time<Duration> const &tp ) {
@@ -873,12 +997,12 @@ namespace daw::date_formatting {
 				result = formats::YearMonthDay<CharT>{ '-' };
 				break;
 			case 'g':
-				result = formats::ISOWeekBasedYear<CharT>{ };
-				break;
-			case 'G':
 				result = formats::ISOWeekBasedYear<CharT>{
 				  formats::locale_name_formats::abbreviated };
 				break;
+			case 'G':
+				result = formats::ISOWeekBasedYear<CharT>{ };
+				break;
 			case 'H':
 				default_width( current_width, 2 );
 				result = formats::Hour<CharT>{ current_width };
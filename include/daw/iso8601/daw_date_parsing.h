@@ -23,8 +23,13 @@
 #pragma once
 
 #include <cctype>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <date/date.h>
+#include <iterator>
+#include <ratio>
+#include <type_traits>
 
 #include <daw/daw_string_view.h>
 
@@ -32,34 +37,52 @@
 
 namespace daw::date_parsing {
 	namespace details {
-		constexpr bool is_delemeter( daw::string_view const &sv ) noexcept {
+		template<typename CharT>
+		constexpr bool
+		is_delemeter( daw::basic_string_view<CharT> const &sv ) noexcept {
 			return !sv.empty( ) && !daw::details::is_digit( sv.front( ) );
 		}
 
-		constexpr int16_t parse_offset( daw::string_view &offset_str ) {
+		// The number of code units of a leading U+2212 MINUS SIGN, 3 in UTF-8 and
+		// 1 in the wider encodings, or 0 when there is none
+		template<typename CharT>
+		constexpr std::size_t
+		unicode_minus_size( daw::basic_string_view<CharT> const &str ) noexcept {
+			if( str.empty( ) ) {
+				return 0;
+			}
+			if constexpr( sizeof( CharT ) == 1 ) {
+				return str.size( ) >= 3 && daw::details::code_unit( str[0] ) == 0xE2 &&
+				           daw::details::code_unit( str[1] ) == 0x88 &&
+				           daw::details::code_unit( str[2] ) == 0x92
+				         ? 3U
+				         : 0U;
+			} else {
+				return daw::details::code_unit( str[0] ) == 0x2212 ? 1U : 0U;
+			}
+		}
+
+		template<typename CharT>
+		constexpr int16_t parse_offset( daw::basic_string_view<CharT> &offset_str ) {
 			if( static_cast<uint8_t>( offset_str.empty( ) ) ||
 			    daw::details::to_lower( offset_str[0] ) == 'z' ) {
 				return 0;
 			}
 
 			auto const is_negative = [&]( ) -> int16_t {
-				switch( static_cast<uint8_t>( offset_str.front( ) ) ) {
+				switch( daw::details::code_unit( offset_str.front( ) ) ) {
 				case '-':
 					offset_str.remove_prefix( 1 );
 					return -1;
-				case 0xE2: // Unicode MINUS SIGN 0x2212, utf-8 0xE2,0x88, 0x92
-					if( offset_str.size( ) >= 3 &&
-					    static_cast<uint8_t>( offset_str[1] ) == 0x88 &&
-					    static_cast<uint8_t>( offset_str[2] ) == 0x92 ) {
-
-						offset_str.remove_prefix( 3 );
-						return -1;
-					}
-					return 1;
 				case '+':
 					offset_str.remove_prefix( 1 );
 					return 1;
 				default:
+					// Unicode MINUS SIGN 0x2212
+					if( auto const n = unicode_minus_size( offset_str ); n > 0 ) {
+						offset_str.remove_prefix( n );
+						return -1;
+					}
 					return 1;
 				}
 			}( );
@@ -82,7 +105,9 @@ namespace daw::date_parsing {
 			return static_cast<int16_t>( offset * is_negative );
 		}
 
-		constexpr auto parse_iso8601_date( daw::string_view &date_str ) noexcept {
+		template<typename CharT>
+		constexpr auto
+		parse_iso8601_date( daw::basic_string_view<CharT> &date_str ) noexcept {
 			struct result_t {
 				uint16_t y;
 				uint8_t m;
@@ -106,7 +131,9 @@ namespace daw::date_parsing {
 			return result;
 		}
 
-		constexpr auto parse_iso8601_time( daw::string_view &time_str ) noexcept {
+		template<typename CharT>
+		constexpr auto
+		parse_iso8601_time( daw::basic_string_view<CharT> &time_str ) noexcept {
 			struct result_t {
 				int8_t h;
 				int8_t m;
@@ -151,17 +178,367 @@ namespace daw::date_parsing {
 			}
 			return result;
 		}
+
+		// Fields of a timestamp as they appear in the text.  offset is in minutes
+		// east of UTC and ns holds up to 9 fractional digits
+		struct timestamp_fields {
+			std::int32_t y = 0;
+			std::uint8_t mo = 0;
+			std::uint8_t d = 0;
+			std::uint8_t h = 0;
+			std::uint8_t mi = 0;
+			std::uint8_t s = 0;
+			std::uint32_t ns = 0;
+			std::int16_t offset = 0;
+		};
+
+		template<typename CharT>
+		constexpr bool try_consume_unsigned( daw::basic_string_view<CharT> &digit_str,
+		                                     std::size_t const count,
+		                                     std::uint32_t &result ) noexcept {
+			if( digit_str.size( ) < count ) {
+				return false;
+			}
+			std::uint32_t value = 0;
+			for( std::size_t n = 0; n < count; ++n ) {
+				auto const digit = daw::details::code_unit( digit_str[n] ) -
+				                   static_cast<std::uint32_t>( '0' );
+				if( digit > 9 ) {
+					return false;
+				}
+				value = value * 10 + digit;
+			}
+			digit_str.remove_prefix( count );
+			result = value;
+			return true;
+		}
+
+		template<typename CharT>
+		constexpr void skip_optional( daw::basic_string_view<CharT> &str,
+		                              char const c ) noexcept {
+			if( !str.empty( ) &&
+			    daw::details::code_unit( str.front( ) ) ==
+			      static_cast<std::uint32_t>( c ) ) {
+				str.remove_prefix( 1 );
+			}
+		}
+
+		constexpr std::uint32_t last_day_of_month( std::int32_t const y,
+		                                           std::uint32_t const m ) noexcept {
+			if( m == 2 ) {
+				return ( y % 4 == 0 && ( y % 100 != 0 || y % 400 == 0 ) ) ? 29U : 28U;
+			}
+			return ( m == 4 || m == 6 || m == 9 || m == 11 ) ? 30U : 31U;
+		}
+
+		// Non-throwing version of parse_offset that rejects anything that is not
+		// empty, Z or [+-]HH[[:]MM]
+		template<typename CharT>
+		constexpr bool try_parse_offset( daw::basic_string_view<CharT> &offset_str,
+		                                 std::int16_t &offset ) noexcept {
+			offset = 0;
+			if( offset_str.empty( ) ) {
+				return true;
+			}
+			if( daw::details::to_lower( offset_str.front( ) ) == 'z' ) {
+				offset_str.remove_prefix( 1 );
+				return true;
+			}
+			std::int32_t sign = 1;
+			switch( daw::details::code_unit( offset_str.front( ) ) ) {
+			case '+':
+				offset_str.remove_prefix( 1 );
+				break;
+			case '-':
+				sign = -1;
+				offset_str.remove_prefix( 1 );
+				break;
+			default:
+				// Unicode MINUS SIGN 0x2212
+				if( auto const n = unicode_minus_size( offset_str ); n > 0 ) {
+					sign = -1;
+					offset_str.remove_prefix( n );
+					break;
+				}
+				return false;
+			}
+			std::uint32_t hours = 0;
+			std::uint32_t minutes = 0;
+			if( !try_consume_unsigned( offset_str, 2, hours ) || hours > 23 ) {
+				return false;
+			}
+			if( !offset_str.empty( ) ) {
+				skip_optional( offset_str, ':' );
+				if( !try_consume_unsigned( offset_str, 2, minutes ) || minutes > 59 ) {
+					return false;
+				}
+			}
+			offset = static_cast<std::int16_t>(
+			  sign * static_cast<std::int32_t>( hours * 60U + minutes ) );
+			return true;
+		}
+
+		// Checked parse of the YYYY[-]MM[-]DD part of a timestamp
+		template<typename CharT>
+		constexpr bool
+		try_parse_iso8601_date( daw::basic_string_view<CharT> &date_str,
+		                        timestamp_fields &result ) noexcept {
+			std::uint32_t y = 0;
+			std::uint32_t mo = 0;
+			std::uint32_t d = 0;
+			if( !try_consume_unsigned( date_str, 4, y ) ) {
+				return false;
+			}
+			skip_optional( date_str, '-' );
+			if( !try_consume_unsigned( date_str, 2, mo ) || mo < 1 || mo > 12 ) {
+				return false;
+			}
+			skip_optional( date_str, '-' );
+			if( !try_consume_unsigned( date_str, 2, d ) || d < 1 ||
+			    d > last_day_of_month( static_cast<std::int32_t>( y ), mo ) ) {
+				return false;
+			}
+			result.y = static_cast<std::int32_t>( y );
+			result.mo = static_cast<std::uint8_t>( mo );
+			result.d = static_cast<std::uint8_t>( d );
+			return true;
+		}
+
+		// Checked parse of everything after the date, from the date/time
+		// separator to the end of the offset
+		template<typename CharT>
+		constexpr bool
+		try_parse_iso8601_time( daw::basic_string_view<CharT> time_str,
+		                        timestamp_fields &result ) noexcept {
+			std::uint32_t h = 0;
+			std::uint32_t mi = 0;
+			std::uint32_t s = 0;
+			if( time_str.empty( ) ) {
+				return false;
+			}
+			switch( daw::details::code_unit( time_str.front( ) ) ) {
+			case 'T':
+			case 't':
+			case ' ':
+				time_str.remove_prefix( 1 );
+				break;
+			default:
+				// The basic layout may omit the separator
+				if( !daw::details::is_digit( time_str.front( ) ) ) {
+					return false;
+				}
+			}
+			if( !try_consume_unsigned( time_str, 2, h ) || h > 23 ) {
+				return false;
+			}
+			skip_optional( time_str, ':' );
+			if( !try_consume_unsigned( time_str, 2, mi ) || mi > 59 ) {
+				return false;
+			}
+			skip_optional( time_str, ':' );
+			if( !try_consume_unsigned( time_str, 2, s ) || s > 60 ) {
+				return false;
+			}
+			std::uint32_t ns = 0;
+			if( !time_str.empty( ) &&
+			    ( time_str.front( ) == '.' || time_str.front( ) == ',' ) ) {
+				time_str.remove_prefix( 1 );
+				if( !daw::details::is_digit( time_str ) ) {
+					return false;
+				}
+				// Accumulate the first 9 digits and scale once at the end
+				std::size_t digits = 0;
+				while( daw::details::is_digit( time_str ) ) {
+					if( digits < 9 ) {
+						ns = ns * 10U +
+						     daw::details::to_integer<std::uint32_t>( time_str.front( ) );
+						++digits;
+					}
+					time_str.remove_prefix( 1 );
+				}
+				constexpr std::uint32_t scales[] = { 1'000'000'000U, 100'000'000U,
+				                                     10'000'000U,    1'000'000U,
+				                                     100'000U,       10'000U,
+				                                     1'000U,         100U,
+				                                     10U,            1U };
+				ns *= scales[digits];
+			}
+			std::int16_t offset = 0;
+			if( !try_parse_offset( time_str, offset ) || !time_str.empty( ) ) {
+				return false;
+			}
+			result.h = static_cast<std::uint8_t>( h );
+			result.mi = static_cast<std::uint8_t>( mi );
+			result.s = static_cast<std::uint8_t>( s );
+			result.ns = ns;
+			result.offset = offset;
+			return true;
+		}
+
+		// Checked parse of a complete timestamp.  Accepts the same basic and
+		// extended layouts as parse_iso8601_timestamp, but validates every field
+		// and reports failure instead of throwing so that it can be used on
+		// columns where invalid values are expected
+		template<typename CharT>
+		constexpr bool
+		try_parse_iso8601_timestamp( daw::basic_string_view<CharT> timestamp_str,
+		                             timestamp_fields &result ) noexcept {
+			return try_parse_iso8601_date( timestamp_str, result ) &&
+			       try_parse_iso8601_time( timestamp_str, result );
+		}
+
+		// Seconds since the epoch in UTC, without building any calendar types
+		constexpr std::int64_t to_epoch_seconds( timestamp_fields const &f ) noexcept {
+			return daw::details::days_from_civil( f.y, f.mo, f.d ) * 86400 +
+			       static_cast<std::int64_t>( f.h ) * 3600 +
+			       static_cast<std::int64_t>( f.mi ) * 60 +
+			       static_cast<std::int64_t>( f.s ) -
+			       static_cast<std::int64_t>( f.offset ) * 60;
+		}
+
+		// Count of Duration units since the epoch.  Sub-second units are built
+		// from whole seconds and the fraction separately so that ns/us do not
+		// overflow the intermediate for far dates
+		template<typename Duration>
+		constexpr std::int64_t to_epoch( timestamp_fields const &f ) noexcept {
+			auto const secs = std::chrono::seconds{ to_epoch_seconds( f ) };
+			if constexpr( std::ratio_greater_equal_v<typename Duration::period,
+			                                         std::ratio<1>> ) {
+				return static_cast<std::int64_t>(
+				  std::chrono::floor<Duration>( secs ).count( ) );
+			} else {
+				return static_cast<std::int64_t>(
+				  ( std::chrono::duration_cast<Duration>( secs ) +
+				    std::chrono::duration_cast<Duration>(
+				      std::chrono::nanoseconds{ f.ns } ) )
+				    .count( ) );
+			}
+		}
 	} // namespace details
 
-	constexpr date::year_month_day
-	parse_iso8601_date( daw::string_view date_str ) {
+	// The parsers accept any contiguous range of char, wchar_t, char8_t,
+	// char16_t or char32_t code units, e.g. daw::basic_string_view,
+	// std::basic_string, std::span or std::vector, and read the code units in
+	// place.  A character array ends at its first nul, or at its extent when
+	// it has none.  Each also has a daw::string_view overload so that char
+	// pointers and { ptr, size } arguments convert as before
+
+	template<typename Range, daw::details::enable_if_char_range<Range> = nullptr>
+	constexpr date::year_month_day parse_iso8601_date( Range const &date_range ) {
+		auto date_str = daw::details::to_string_view( date_range );
 		auto const tmp = details::parse_iso8601_date( date_str );
 		return date::year_month_day{ date::year{ tmp.y }, date::month( tmp.m ),
 		                             date::day( tmp.d ) };
 	}
 
+	constexpr date::year_month_day
+	parse_iso8601_date( daw::string_view const date_str ) {
+		return parse_iso8601_date<daw::string_view>( date_str );
+	}
+
+	namespace details {
+		// YYYY[-]DDD, the day of the year
+		template<typename CharT>
+		constexpr bool
+		try_parse_iso8601_ordinal_date( daw::basic_string_view<CharT> date_str,
+		                                timestamp_fields &result ) noexcept {
+			std::uint32_t y = 0;
+			std::uint32_t doy = 0;
+			if( !try_consume_unsigned( date_str, 4, y ) ) {
+				return false;
+			}
+			skip_optional( date_str, '-' );
+			auto const yr = static_cast<std::int32_t>( y );
+			if( !try_consume_unsigned( date_str, 3, doy ) || !date_str.empty( ) ||
+			    doy < 1 || doy > 365U + ( last_day_of_month( yr, 2 ) - 28U ) ) {
+				return false;
+			}
+			auto const ymd = daw::details::civil_from_days(
+			  daw::details::days_from_civil( yr, 1, 1 ) + doy - 1 );
+			result.y = ymd.y;
+			result.mo = static_cast<std::uint8_t>( ymd.m );
+			result.d = static_cast<std::uint8_t>( ymd.d );
+			return true;
+		}
+
+		// YYYY[-]Www[[-]D], the ISO week based year, the week and the weekday.
+		// Without a weekday the Monday of the week is used
+		template<typename CharT>
+		constexpr bool
+		try_parse_iso8601_week_date( daw::basic_string_view<CharT> date_str,
+		                             timestamp_fields &result ) noexcept {
+			std::uint32_t y = 0;
+			std::uint32_t week = 0;
+			std::uint32_t wd = 1;
+			if( !try_consume_unsigned( date_str, 4, y ) ) {
+				return false;
+			}
+			skip_optional( date_str, '-' );
+			if( date_str.empty( ) || ( date_str.front( ) != 'W' &&
+			                           date_str.front( ) != 'w' ) ) {
+				return false;
+			}
+			date_str.remove_prefix( 1 );
+			auto const yr = static_cast<std::int32_t>( y );
+			if( !try_consume_unsigned( date_str, 2, week ) || week < 1 ||
+			    week > daw::details::iso_weeks_in_year( yr ) ) {
+				return false;
+			}
+			if( !date_str.empty( ) ) {
+				skip_optional( date_str, '-' );
+				if( !try_consume_unsigned( date_str, 1, wd ) || wd < 1 || wd > 7 ||
+				    !date_str.empty( ) ) {
+					return false;
+				}
+			}
+			auto const ymd = daw::details::civil_from_days(
+			  daw::details::days_from_iso_week_date( yr, week, wd ) );
+			result.y = ymd.y;
+			result.mo = static_cast<std::uint8_t>( ymd.m );
+			result.d = static_cast<std::uint8_t>( ymd.d );
+			return true;
+		}
+	} // namespace details
+
+	/// Parse an ISO 8601 ordinal date, YYYY-DDD or YYYYDDD
+	template<typename Range, daw::details::enable_if_char_range<Range> = nullptr>
+	constexpr date::year_month_day
+	parse_iso8601_ordinal_date( Range const &date_str ) {
+		details::timestamp_fields tmp{ };
+		daw::exception::precondition_check<invalid_iso8601_timestamp>(
+		  details::try_parse_iso8601_ordinal_date(
+		    daw::details::to_string_view( date_str ), tmp ) );
+		return date::year_month_day{ date::year{ tmp.y }, date::month( tmp.mo ),
+		                             date::day( tmp.d ) };
+	}
+
+	constexpr date::year_month_day
+	parse_iso8601_ordinal_date( daw::string_view const date_str ) {
+		return parse_iso8601_ordinal_date<daw::string_view>( date_str );
+	}
+
+	/// Parse an ISO 8601 week date, YYYY-Www-D or YYYYWwwD, where the weekday
+	/// is optional and defaults to Monday
+	template<typename Range, daw::details::enable_if_char_range<Range> = nullptr>
+	constexpr date::year_month_day
+	parse_iso8601_week_date( Range const &date_str ) {
+		details::timestamp_fields tmp{ };
+		daw::exception::precondition_check<invalid_iso8601_timestamp>(
+		  details::try_parse_iso8601_week_date(
+		    daw::details::to_string_view( date_str ), tmp ) );
+		return date::year_month_day{ date::year{ tmp.y }, date::month( tmp.mo ),
+		                             date::day( tmp.d ) };
+	}
+
+	constexpr date::year_month_day
+	parse_iso8601_week_date( daw::string_view const date_str ) {
+		return parse_iso8601_week_date<daw::string_view>( date_str );
+	}
+
+	template<typename Range, daw::details::enable_if_char_range<Range> = nullptr>
 	constexpr std::chrono::milliseconds
-	parse_iso8601_time( daw::string_view time_str ) {
+	parse_iso8601_time( Range const &time_range ) {
+		auto time_str = daw::details::to_string_view( time_range );
 		auto const tmp = details::parse_iso8601_time( time_str );
 		std::chrono::milliseconds result =
 		  std::chrono::hours{ tmp.h } + std::chrono::minutes{ tmp.m } +
@@ -170,9 +547,16 @@ namespace daw::date_parsing {
 		return result;
 	}
 
+	constexpr std::chrono::milliseconds
+	parse_iso8601_time( daw::string_view const time_str ) {
+		return parse_iso8601_time<daw::string_view>( time_str );
+	}
+
+	template<typename Range, daw::details::enable_if_char_range<Range> = nullptr>
 	constexpr std::chrono::time_point<std::chrono::system_clock,
 	                                  std::chrono::milliseconds>
-	parse_iso8601_timestamp( daw::string_view timestamp_str ) {
+	parse_iso8601_timestamp( Range const &timestamp_range ) {
+		auto timestamp_str = daw::details::to_string_view( timestamp_range );
 		auto const dte = details::parse_iso8601_date( timestamp_str );
 		if( details::is_delemeter( timestamp_str ) ) {
 			timestamp_str.remove_prefix( 1 );
@@ -190,66 +574,320 @@ namespace daw::date_parsing {
 		result = result - std::chrono::minutes{ ofst };
 		return result;
 	}
-	template<typename CharT, typename Traits>
-	std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>
-	parse_iso8601_timestamp(
-	  std::basic_string<CharT, Traits> const &timestamp_str ) {
-		return parse_iso8601_timestamp( timestamp_str );
-	}
 
-	template<typename CharT, size_t N>
 	constexpr std::chrono::time_point<std::chrono::system_clock,
 	                                  std::chrono::milliseconds>
-	parse_iso8601_timestamp( CharT const ( &timestamp_str )[N] ) {
-		return parse_iso8601_timestamp(
-		  daw::basic_string_view<CharT>{ timestamp_str, N - 1 } );
+	parse_iso8601_timestamp( daw::string_view const timestamp_str ) {
+		return parse_iso8601_timestamp<daw::string_view>( timestamp_str );
 	}
 
-	template<typename CharT, string_view_bounds_type Bounds>
-	constexpr std::chrono::time_point<std::chrono::system_clock,
-	                                  std::chrono::milliseconds>
-	parse_javascript_timestamp(
-	  daw::basic_string_view<CharT, Bounds> timestamp_str ) {
-		daw::exception::precondition_check<invalid_javascript_timestamp>(
-		  timestamp_str.size( ) == 24 and
-		  daw::details::to_lower( timestamp_str[23] ) == 'z' );
-		auto const yr =
-		  daw::details::parse_unsigned<uint16_t, 4>( timestamp_str.data( ) );
-		auto const mo =
-		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 5 );
-		auto const dy =
-		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 8 );
-		auto const hr =
-		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 11 );
-		auto const mi =
-		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 14 );
-		auto const sc =
-		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 17 );
-		auto const ms =
-		  daw::details::parse_unsigned<uint16_t, 3>( timestamp_str.data( ) + 20 );
+	namespace details {
+		constexpr std::int64_t floor_div( std::int64_t const num,
+		                                  std::int64_t const den ) noexcept {
+			auto const q = num / den;
+			return ( num % den != 0 && ( num < 0 ) != ( den < 0 ) ) ? q - 1 : q;
+		}
 
-		std::chrono::time_point<std::chrono::system_clock,
-		                        std::chrono::milliseconds>
-		  result{ date::sys_days{ date::year{ yr } / date::month( mo ) /
-		                          date::day( dy ) } +
-		          std::chrono::hours{ hr } + std::chrono::minutes{ mi } +
-		          std::chrono::seconds{ sc } + std::chrono::milliseconds{ ms } };
+		// Bucket index of a timestamp.  A time field is only skipped when the
+		// bucket size is a whole number of the field above it, e.g. minutes for
+		// a bucket of whole hours, so that the skipped fields cannot cross a
+		// bucket boundary.  The hours and minutes an offset reaches into are
+		// always converted.  The fraction is skipped and fields that are not
+		// converted are not validated
+		template<typename Bucket, typename CharT>
+		constexpr bool try_parse_iso8601_bucket( daw::basic_string_view<CharT> ts,
+		                                         std::int64_t &bucket ) noexcept {
+			using bucket_secs =
+			  std::ratio_divide<typename Bucket::period, std::ratio<1>>;
+			static_assert( bucket_secs::den == 1,
+			               "Buckets must be a whole number of seconds" );
+			constexpr auto bucket_size =
+			  static_cast<std::int64_t>( bucket_secs::num ) * Bucket( 1 ).count( );
+			static_assert( bucket_size > 0, "Buckets must be positive" );
+
+			timestamp_fields f{ };
+			if( !try_parse_iso8601_date( ts, f ) || ts.empty( ) ) {
+				return false;
+			}
+			switch( daw::details::code_unit( ts.front( ) ) ) {
+			case 'T':
+			case 't':
+			case ' ':
+				ts.remove_prefix( 1 );
+				break;
+			default:
+				// The basic layout may omit the separator
+				if( !daw::details::is_digit( ts.front( ) ) ) {
+					return false;
+				}
+			}
+			bool const is_extended = ts.size( ) > 2 && ts[2] == ':';
+			std::size_t const time_size = is_extended ? 8U : 6U;
+			if( ts.size( ) < time_size ) {
+				return false;
+			}
+			auto rest = ts.substr( time_size );
+			if( !rest.empty( ) && ( rest.front( ) == '.' || rest.front( ) == ',' ) ) {
+				rest.remove_prefix( 1 );
+				while( daw::details::is_digit( rest ) ) {
+					rest.remove_prefix( 1 );
+				}
+			}
+			std::int16_t offset = 0;
+			if( !try_parse_offset( rest, offset ) || !rest.empty( ) ) {
+				return false;
+			}
+
+			std::int64_t secs = daw::details::days_from_civil( f.y, f.mo, f.d ) * 86400;
+			auto const field = [&]( std::size_t const n, std::uint32_t const max,
+			                        std::int64_t const scale ) {
+				auto digits = ts.substr( is_extended ? n * 3U : n * 2U );
+				std::uint32_t value = 0;
+				if( !try_consume_unsigned( digits, 2, value ) || value > max ) {
+					return false;
+				}
+				secs += static_cast<std::int64_t>( value ) * scale;
+				return true;
+			};
+			if( ( bucket_size % 86400 != 0 || offset != 0 ) &&
+			    !field( 0, 23, 3600 ) ) {
+				return false;
+			}
+			if( ( bucket_size % 3600 != 0 || offset % 60 != 0 ) &&
+			    !field( 1, 59, 60 ) ) {
+				return false;
+			}
+			if( bucket_size % 60 != 0 && !field( 2, 60, 1 ) ) {
+				return false;
+			}
+			bucket = floor_div( secs - static_cast<std::int64_t>( offset ) * 60,
+			                    bucket_size );
+			return true;
+		}
 
+		template<typename Bucket, typename CharT>
+		constexpr void count_bucket( daw::basic_string_view<CharT> const ts,
+		                             std::int64_t const first_bucket,
+		                             std::uint64_t *counts,
+		                             std::size_t const bucket_count,
+		                             std::size_t &skipped ) noexcept {
+			std::int64_t bucket = 0;
+			if( !try_parse_iso8601_bucket<Bucket>( ts, bucket ) ||
+			    bucket < first_bucket ||
+			    static_cast<std::uint64_t>( bucket - first_bucket ) >= bucket_count ) {
+				++skipped;
+				return;
+			}
+			++counts[bucket - first_bucket];
+		}
+	} // namespace details
+
+	/// Index of the Bucket sized interval since the epoch that an ISO 8601
+	/// timestamp falls in, e.g. parse_iso8601_bucket<std::chrono::hours>.
+	/// Equivalent to flooring parse_iso8601_timestamp to Bucket, but fields
+	/// below the bucket size are not converted
+	template<typename Bucket, typename Range,
+	         daw::details::enable_if_char_range<Range> = nullptr>
+	constexpr std::int64_t parse_iso8601_bucket( Range const &timestamp_str ) {
+		std::int64_t result = 0;
+		daw::exception::precondition_check<invalid_iso8601_timestamp>(
+		  details::try_parse_iso8601_bucket<Bucket>(
+		    daw::details::to_string_view( timestamp_str ), result ) );
 		return result;
 	}
 
-	template<typename CharT, typename Traits>
-	std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>
-	parse_javascript_timestamp(
-	  std::basic_string<CharT, Traits> const &timestamp_str ) {
-		return parse_javascript_timestamp( timestamp_str );
+	template<typename Bucket>
+	constexpr std::int64_t
+	parse_iso8601_bucket( daw::string_view const timestamp_str ) {
+		return parse_iso8601_bucket<Bucket, daw::string_view>( timestamp_str );
+	}
+
+	/// Count each timestamp in [first, last) into counts[bucket - first_bucket]
+	/// for the bucket_count buckets starting at first_bucket
+	/// @return the number of timestamps that were invalid or out of range
+	template<typename Bucket, typename ForwardIterator>
+	constexpr std::size_t
+	iso8601_histogram( ForwardIterator first, ForwardIterator const last,
+	                   std::int64_t const first_bucket, std::uint64_t *counts,
+	                   std::size_t const bucket_count ) noexcept {
+		std::size_t skipped = 0;
+		for( ; first != last; ++first ) {
+			details::count_bucket<Bucket>( daw::details::to_string_view( *first ),
+			                               first_bucket, counts, bucket_count,
+			                               skipped );
+		}
+		return skipped;
+	}
+
+	/// As iso8601_histogram, for newline separated timestamps.  Empty lines are
+	/// ignored
+	template<typename Bucket, typename Range,
+	         daw::details::enable_if_char_range<Range> = nullptr>
+	constexpr std::size_t iso8601_histogram_lines(
+	  Range const &lines_range, std::int64_t const first_bucket,
+	  std::uint64_t *counts, std::size_t const bucket_count ) noexcept {
+		auto lines = daw::details::to_string_view( lines_range );
+		using char_t = typename decltype( lines )::value_type;
+		std::size_t skipped = 0;
+		while( !lines.empty( ) ) {
+			auto const pos = lines.find_first_of( static_cast<char_t>( '\n' ) );
+			auto line = lines.substr( 0, pos );
+			lines.remove_prefix( pos == decltype( lines )::npos ? lines.size( )
+			                                                    : pos + 1U );
+			if( !line.empty( ) && line.back( ) == '\r' ) {
+				line.remove_suffix( 1 );
+			}
+			if( !line.empty( ) ) {
+				details::count_bucket<Bucket>( line, first_bucket, counts,
+				                               bucket_count, skipped );
+			}
+		}
+		return skipped;
+	}
+
+	namespace details {
+		// YYYY-MM-DDTHH:MM:SS.sssZ as produced by Date.prototype.toISOString.
+		// Only the length and the Z are checked
+		template<typename CharT>
+		constexpr bool
+		is_javascript_timestamp( daw::basic_string_view<CharT> const str ) noexcept {
+			return str.size( ) == 24 and daw::details::to_lower( str[23] ) == 'z';
+		}
+
+		template<typename CharT>
+		constexpr timestamp_fields
+		parse_javascript_fields( daw::basic_string_view<CharT> const str ) noexcept {
+			auto const *ptr = str.data( );
+			timestamp_fields result{ };
+			result.y = daw::details::parse_unsigned<std::int32_t, 4>( ptr );
+			result.mo = daw::details::parse_unsigned<std::uint8_t, 2>( ptr + 5 );
+			result.d = daw::details::parse_unsigned<std::uint8_t, 2>( ptr + 8 );
+			result.h = daw::details::parse_unsigned<std::uint8_t, 2>( ptr + 11 );
+			result.mi = daw::details::parse_unsigned<std::uint8_t, 2>( ptr + 14 );
+			result.s = daw::details::parse_unsigned<std::uint8_t, 2>( ptr + 17 );
+			result.ns =
+			  daw::details::parse_unsigned<std::uint32_t, 3>( ptr + 20 ) * 1'000'000U;
+			return result;
+		}
+	} // namespace details
+
+	template<typename Range, daw::details::enable_if_char_range<Range> = nullptr>
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::milliseconds>
+	parse_javascript_timestamp( Range const &timestamp_range ) {
+		auto const timestamp_str = daw::details::to_string_view( timestamp_range );
+		daw::exception::precondition_check<invalid_javascript_timestamp>(
+		  details::is_javascript_timestamp( timestamp_str ) );
+		return std::chrono::time_point<std::chrono::system_clock,
+		                               std::chrono::milliseconds>(
+		  std::chrono::milliseconds( details::to_epoch<std::chrono::milliseconds>(
+		    details::parse_javascript_fields( timestamp_str ) ) ) );
 	}
 
-	template<typename CharT, size_t N>
 	constexpr std::chrono::time_point<std::chrono::system_clock,
 	                                  std::chrono::milliseconds>
-	parse_javascript_timestamp( CharT const ( &timestamp_str )[N] ) {
-		return parse_javascript_timestamp(
-		  daw::basic_string_view<CharT>{ timestamp_str, N - 1 } );
+	parse_javascript_timestamp( daw::string_view const timestamp_str ) {
+		return parse_javascript_timestamp<daw::string_view>( timestamp_str );
+	}
+
+	/// Parse an ISO 8601 timestamp to a count of Unit since the epoch, straight
+	/// from the field arithmetic.  The fields are validated as in
+	/// parse_iso8601_column and the fraction is kept to nanoseconds
+	template<typename Unit = std::chrono::milliseconds, typename Range,
+	         daw::details::enable_if_char_range<Range> = nullptr>
+	constexpr std::int64_t
+	parse_iso8601_timestamp_to_epoch( Range const &timestamp_str ) {
+		details::timestamp_fields fields{ };
+		daw::exception::precondition_check<invalid_iso8601_timestamp>(
+		  details::try_parse_iso8601_timestamp(
+		    daw::details::to_string_view( timestamp_str ), fields ) );
+		return details::to_epoch<Unit>( fields );
+	}
+
+	template<typename Unit = std::chrono::milliseconds>
+	constexpr std::int64_t
+	parse_iso8601_timestamp_to_epoch( daw::string_view const timestamp_str ) {
+		return parse_iso8601_timestamp_to_epoch<Unit, daw::string_view>(
+		  timestamp_str );
+	}
+
+	/// parse_javascript_timestamp as a count of Unit since the epoch
+	template<typename Unit = std::chrono::milliseconds, typename Range,
+	         daw::details::enable_if_char_range<Range> = nullptr>
+	constexpr std::int64_t
+	parse_javascript_timestamp_to_epoch( Range const &timestamp_range ) {
+		auto const timestamp_str = daw::details::to_string_view( timestamp_range );
+		daw::exception::precondition_check<invalid_javascript_timestamp>(
+		  details::is_javascript_timestamp( timestamp_str ) );
+		return details::to_epoch<Unit>(
+		  details::parse_javascript_fields( timestamp_str ) );
+	}
+
+	template<typename Unit = std::chrono::milliseconds>
+	constexpr std::int64_t
+	parse_javascript_timestamp_to_epoch( daw::string_view const timestamp_str ) {
+		return parse_javascript_timestamp_to_epoch<Unit, daw::string_view>(
+		  timestamp_str );
+	}
+
+	namespace details {
+		// Write a count of Unit to an output of std::int64_t, or of time points
+		// in Unit such as std::back_inserter of a compressed_timestamp_column
+		template<typename Unit, typename OutputIterator>
+		constexpr void write_epoch( OutputIterator &out, std::int64_t const value ) {
+			if constexpr( std::is_assignable_v<decltype( *out ), std::int64_t> ) {
+				*out = value;
+			} else {
+				*out = std::chrono::time_point<std::chrono::system_clock, Unit>(
+				  Unit( value ) );
+			}
+			++out;
+		}
+	} // namespace details
+
+	/// Parse each timestamp in [first, last) to out as a count of Unit since
+	/// the epoch.  Invalid timestamps are written as 0.  out is an
+	/// std::int64_t * or an output iterator of std::int64_t or of time points
+	/// in Unit, e.g. std::back_inserter of a compressed_timestamp_column
+	/// @return the number of invalid timestamps
+	template<typename Unit = std::chrono::milliseconds,
+	         typename ForwardIterator, typename OutputIterator>
+	constexpr std::size_t
+	parse_iso8601_timestamps_to_epoch( ForwardIterator first,
+	                                   ForwardIterator const last,
+	                                   OutputIterator out ) {
+		std::size_t invalid_count = 0;
+		for( ; first != last; ++first ) {
+			details::timestamp_fields fields{ };
+			if( details::try_parse_iso8601_timestamp(
+			      daw::details::to_string_view( *first ), fields ) ) {
+				details::write_epoch<Unit>( out, details::to_epoch<Unit>( fields ) );
+			} else {
+				details::write_epoch<Unit>( out, 0 );
+				++invalid_count;
+			}
+		}
+		return invalid_count;
+	}
+
+	/// As parse_iso8601_timestamps_to_epoch for JavaScript timestamps
+	template<typename Unit = std::chrono::milliseconds,
+	         typename ForwardIterator, typename OutputIterator>
+	constexpr std::size_t
+	parse_javascript_timestamps_to_epoch( ForwardIterator first,
+	                                      ForwardIterator const last,
+	                                      OutputIterator out ) {
+		std::size_t invalid_count = 0;
+		for( ; first != last; ++first ) {
+			auto const str = daw::details::to_string_view( *first );
+			if( details::is_javascript_timestamp( str ) ) {
+				details::write_epoch<Unit>(
+				  out, details::to_epoch<Unit>( details::parse_javascript_fields( str ) ) );
+			} else {
+				details::write_epoch<Unit>( out, 0 );
+				++invalid_count;
+			}
+		}
+		return invalid_count;
 	}
 } // namespace daw::date_parsing
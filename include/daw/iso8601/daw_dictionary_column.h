@@ -0,0 +1,247 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <daw/daw_string_view.h>
+
+#include "daw_arrow_column.h"
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	struct dictionary_column_options {
+		/// Number of distinct valid values after which the column is no longer
+		/// dictionary encoded and every remaining row is parsed
+		std::size_t max_cardinality = 256;
+	};
+
+	/// A timestamp column that is either dictionary encoded, indices into
+	/// dictionary, or plain values once the cardinality was too high.  Both
+	/// hold counts of Duration since the epoch.  validity is an Arrow validity
+	/// bitmap and null rows have an index or value of 0
+	template<typename Duration = std::chrono::milliseconds>
+	struct dictionary_timestamp_column {
+		using duration = Duration;
+		using time_point_t =
+		  std::chrono::time_point<std::chrono::system_clock, Duration>;
+
+		std::vector<std::int32_t> indices{ };
+		std::vector<std::int64_t> dictionary{ };
+		std::vector<std::int64_t> values{ };
+		std::vector<std::uint8_t> validity{ };
+		std::size_t null_count = 0;
+		bool is_dictionary_encoded = true;
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return is_dictionary_encoded ? indices.size( ) : values.size( );
+		}
+
+		[[nodiscard]] bool is_valid( std::size_t const n ) const noexcept {
+			return details::get_bit( validity.data( ), n );
+		}
+
+		/// The count of Duration for row n, 0 for a null row.  The dictionary is
+		/// empty when every row is null, so null rows are not looked up in it
+		[[nodiscard]] std::int64_t value( std::size_t const n ) const noexcept {
+			if( not is_dictionary_encoded ) {
+				return values[n];
+			}
+			return is_valid( n )
+			         ? dictionary[static_cast<std::size_t>( indices[n] )]
+			         : 0;
+		}
+
+		[[nodiscard]] time_point_t operator[]( std::size_t const n ) const noexcept {
+			return time_point_t( Duration( value( n ) ) );
+		}
+	};
+
+	namespace details {
+		// FNV-1a over the raw slice.  The slices are short, so this is cheaper
+		// than parsing them
+		constexpr std::uint64_t hash_slice( daw::string_view const str ) noexcept {
+			std::uint64_t result = 0xcbf2'9ce4'8422'2325ULL;
+			for( auto const c : str ) {
+				result ^= static_cast<unsigned char>( c );
+				result *= 0x0000'0100'0000'01B3ULL;
+			}
+			return result;
+		}
+
+		// Open addressing table from raw slice to dictionary index, or to
+		// invalid_code for slices that did not parse
+		class slice_dictionary {
+			struct slot {
+				std::uint64_t hash = 0;
+				char const *first = nullptr;
+				std::size_t size = 0;
+				std::int32_t code = 0;
+			};
+			std::vector<slot> m_slots;
+			std::size_t m_mask;
+			std::size_t m_used = 0;
+
+		public:
+			static constexpr std::int32_t invalid_code = -1;
+
+			explicit slice_dictionary( std::size_t const max_entries ) {
+				std::size_t capacity = 16;
+				// Keep the load at or below 3/4 when full
+				while( capacity < max_entries + max_entries / 3U + 1U ) {
+					capacity *= 2U;
+				}
+				m_slots.resize( capacity );
+				m_mask = capacity - 1U;
+			}
+
+			[[nodiscard]] std::size_t used( ) const noexcept {
+				return m_used;
+			}
+
+			/// The slot for str, empty when str has not been inserted
+			[[nodiscard]] slot &find( daw::string_view const str,
+			                          std::uint64_t const hash ) noexcept {
+				auto pos = static_cast<std::size_t>( hash ) & m_mask;
+				while( true ) {
+					auto &s = m_slots[pos];
+					if( s.first == nullptr or
+					    ( s.hash == hash and s.size == str.size( ) and
+					      std::memcmp( s.first, str.data( ), str.size( ) ) == 0 ) ) {
+						return s;
+					}
+					pos = ( pos + 1U ) & m_mask;
+				}
+			}
+
+			static bool is_empty( slot const &s ) noexcept {
+				return s.first == nullptr;
+			}
+
+			void insert( slot &s, daw::string_view const str,
+			             std::uint64_t const hash, std::int32_t const code ) noexcept {
+				// Empty slices are stored with a non-null pointer so that the slot is
+				// not seen as empty
+				s = slot{ hash, str.data( ) == nullptr ? "" : str.data( ), str.size( ),
+				          code };
+				++m_used;
+			}
+		};
+	} // namespace details
+
+	/// Parse the Arrow string column described by offsets[0, length] and data
+	/// as a dictionary of distinct time points and an index per row.  Each raw
+	/// slice is hashed and looked up before it is parsed, so a repeated value
+	/// is parsed once.  When the number of distinct values exceeds
+	/// options.max_cardinality, the rows so far are expanded into values and
+	/// the rest of the column is parsed without the dictionary
+	template<typename Duration = std::chrono::milliseconds, typename Offset>
+	dictionary_timestamp_column<Duration> parse_iso8601_dictionary_column(
+	  Offset const *offsets, char const *data, std::size_t const length,
+	  std::uint8_t const *input_validity = nullptr,
+	  dictionary_column_options const &options = { } ) {
+		static_assert( std::is_same_v<Offset, std::int32_t> or
+		                 std::is_same_v<Offset, std::int64_t>,
+		               "Arrow string offsets are int32_t or int64_t" );
+		dictionary_timestamp_column<Duration> result{ };
+		result.indices.resize( length );
+		result.validity.resize( ( length + 7U ) / 8U );
+		// Invalid slices are cached too, until the table holds twice as many
+		// entries as there may be values
+		auto table = details::slice_dictionary( 3U * options.max_cardinality );
+
+		auto const parse = [&]( daw::string_view const str, std::int64_t &value ) {
+			details::timestamp_fields fields{ };
+			if( not details::try_parse_iso8601_timestamp( str, fields ) ) {
+				return false;
+			}
+			value = details::to_epoch<Duration>( fields );
+			return true;
+		};
+
+		for( std::size_t n = 0; n < length; ++n ) {
+			bool is_valid = false;
+			if( input_validity == nullptr or details::get_bit( input_validity, n ) ) {
+				auto const str = daw::string_view(
+				  data + offsets[n],
+				  static_cast<std::size_t>( offsets[n + 1] - offsets[n] ) );
+				if( result.is_dictionary_encoded ) {
+					auto const hash = details::hash_slice( str );
+					auto &slot = table.find( str, hash );
+					std::int32_t code = 0;
+					if( not details::slice_dictionary::is_empty( slot ) ) {
+						code = slot.code;
+					} else {
+						std::int64_t value = 0;
+						if( not parse( str, value ) ) {
+							code = details::slice_dictionary::invalid_code;
+							if( table.used( ) < 2U * options.max_cardinality ) {
+								table.insert( slot, str, hash, code );
+							}
+						} else if( result.dictionary.size( ) < options.max_cardinality ) {
+							code = static_cast<std::int32_t>( result.dictionary.size( ) );
+							result.dictionary.push_back( value );
+							table.insert( slot, str, hash, code );
+						} else {
+							// Too many distinct values, expand what has been seen so far
+							result.values.resize( length );
+							for( std::size_t m = 0; m < n; ++m ) {
+								if( result.is_valid( m ) ) {
+									result.values[m] =
+									  result.dictionary[static_cast<std::size_t>(
+									    result.indices[m] )];
+								}
+							}
+							result.indices = std::vector<std::int32_t>( );
+							result.dictionary = std::vector<std::int64_t>( );
+							result.is_dictionary_encoded = false;
+							result.values[n] = value;
+							code = 0;
+						}
+					}
+					if( code != details::slice_dictionary::invalid_code ) {
+						is_valid = true;
+						if( result.is_dictionary_encoded ) {
+							result.indices[n] = code;
+						}
+					}
+				} else {
+					is_valid = parse( str, result.values[n] );
+				}
+			}
+			if( is_valid ) {
+				result.validity[n / 8U] |=
+				  static_cast<std::uint8_t>( 1U << ( n % 8U ) );
+			} else {
+				++result.null_count;
+			}
+		}
+		return result;
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,439 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+
+#include "daw_common.h"
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	namespace details {
+		// The components of an ISO 8601 duration.  Years and months have no
+		// fixed length, so whole ones are kept apart for calendar arithmetic.
+		// Everything else, including fractional years and months at their
+		// average length, is in seconds and nanoseconds
+		struct duration_fields {
+			bool is_negative = false;
+			std::int64_t years = 0;
+			std::int64_t months = 0;
+			std::int64_t seconds = 0;
+			std::int64_t nanoseconds = 0;
+		};
+
+		// The average Gregorian year and month, as date::years and date::months
+		inline constexpr std::int64_t seconds_per_year = 31'556'952;
+		inline constexpr std::int64_t seconds_per_month = 2'629'746;
+
+		// n[(.|,)f] with up to 18 digits before and 9 after the separator.  The
+		// fraction is returned scaled to nanoseconds of the unit
+		constexpr bool try_parse_duration_number( daw::string_view &str,
+		                                          std::int64_t &whole,
+		                                          std::int64_t &fraction ) noexcept {
+			whole = 0;
+			fraction = 0;
+			std::size_t digits = 0;
+			while( daw::details::is_digit( str ) ) {
+				if( ++digits > 18 ) {
+					return false;
+				}
+				whole = whole * 10 + daw::details::to_integer<std::int64_t>( str.front( ) );
+				str.remove_prefix( 1 );
+			}
+			if( !str.empty( ) && ( str.front( ) == '.' || str.front( ) == ',' ) ) {
+				str.remove_prefix( 1 );
+				if( !daw::details::is_digit( str ) ) {
+					return false;
+				}
+				std::int64_t scale = 100'000'000;
+				while( daw::details::is_digit( str ) ) {
+					fraction += scale * daw::details::to_integer<std::int64_t>( str.front( ) );
+					scale /= 10;
+					str.remove_prefix( 1 );
+				}
+			}
+			return digits > 0;
+		}
+
+		// PnYnMnWnDTnHnMnS, with each component optional but in that order, at
+		// least one present, and a T only when a time component follows.  A
+		// leading - negates the duration
+		constexpr bool try_parse_iso8601_duration( daw::string_view str,
+		                                           duration_fields &result ) noexcept {
+			result = duration_fields{ };
+			if( !str.empty( ) && str.front( ) == '-' ) {
+				result.is_negative = true;
+				str.remove_prefix( 1 );
+			}
+			if( str.empty( ) || ( str.front( ) != 'P' && str.front( ) != 'p' ) ) {
+				return false;
+			}
+			str.remove_prefix( 1 );
+			// Unit designators in the order they may appear; M is months before the
+			// T and minutes after it
+			constexpr char date_units[] = "YMWD";
+			constexpr std::int64_t date_unit_seconds[] = {
+			  seconds_per_year, seconds_per_month, 7 * 86'400, 86'400 };
+			constexpr char time_units[] = "HMS";
+			constexpr std::int64_t time_unit_seconds[] = { 3'600, 60, 1 };
+
+			char const *units = date_units;
+			std::int64_t const *unit_seconds = date_unit_seconds;
+			std::size_t unit_count = 4;
+			std::size_t next_unit = 0;
+			bool is_time = false;
+			bool has_component = false;
+			while( !str.empty( ) ) {
+				if( str.front( ) == 'T' || str.front( ) == 't' ) {
+					if( is_time ) {
+						return false;
+					}
+					is_time = true;
+					units = time_units;
+					unit_seconds = time_unit_seconds;
+					unit_count = 3;
+					next_unit = 0;
+					str.remove_prefix( 1 );
+					if( str.empty( ) ) {
+						return false;
+					}
+					continue;
+				}
+				std::int64_t whole = 0;
+				std::int64_t fraction = 0;
+				if( !try_parse_duration_number( str, whole, fraction ) || str.empty( ) ) {
+					return false;
+				}
+				auto const unit = static_cast<char>( str.front( ) & ~0x20 );
+				str.remove_prefix( 1 );
+				while( next_unit < unit_count && units[next_unit] != unit ) {
+					++next_unit;
+				}
+				if( next_unit == unit_count ) {
+					return false;
+				}
+				auto const secs = unit_seconds[next_unit];
+				if( !is_time && next_unit == 0 && fraction == 0 ) {
+					result.years = whole;
+				} else if( !is_time && next_unit == 1 && fraction == 0 ) {
+					result.months = whole;
+				} else {
+					if( whole > INT64_MAX / secs - result.seconds ) {
+						return false;
+					}
+					result.seconds += whole * secs;
+					// secs * fraction is at most a year in nanoseconds
+					result.nanoseconds += secs * fraction;
+					result.seconds += result.nanoseconds / 1'000'000'000;
+					result.nanoseconds %= 1'000'000'000;
+				}
+				++next_unit;
+				has_component = true;
+				// Only the last component may have a fraction
+				if( fraction != 0 && !str.empty( ) ) {
+					return false;
+				}
+			}
+			return has_component;
+		}
+
+		constexpr bool checked_add( std::int64_t const lhs, std::int64_t const rhs,
+		                            std::int64_t &result ) noexcept {
+			if( ( rhs > 0 && lhs > INT64_MAX - rhs ) ||
+			    ( rhs < 0 && lhs < INT64_MIN - rhs ) ) {
+				return false;
+			}
+			result = lhs + rhs;
+			return true;
+		}
+
+		// Count of Duration in secs seconds and ns nanoseconds, rounded down, and
+		// fail when it does not fit in Duration
+		template<typename Duration>
+		constexpr bool seconds_to( std::int64_t const secs, std::int64_t const ns,
+		                           std::int64_t &count ) noexcept {
+			using period = typename Duration::period;
+			using factor = std::ratio_divide<std::ratio<1>, period>;
+			using count_t = std::chrono::duration<std::int64_t, period>;
+			// The fraction is less than a second, so a margin of one second keeps
+			// the sum in range
+			if constexpr( factor::den == 1 && factor::num > 1 ) {
+				if( secs >= INT64_MAX / factor::num || secs <= INT64_MIN / factor::num ) {
+					return false;
+				}
+			}
+			count = std::chrono::floor<count_t>( std::chrono::seconds( secs ) ).count( ) +
+			        std::chrono::floor<count_t>( std::chrono::nanoseconds( ns ) ).count( );
+			using rep = typename Duration::rep;
+			if constexpr( std::is_integral_v<rep> && sizeof( rep ) < sizeof( count ) ) {
+				if( count > std::numeric_limits<rep>::max( ) ||
+				    count < -static_cast<std::int64_t>( std::numeric_limits<rep>::max( ) ) ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template<typename Duration>
+		constexpr bool try_to_duration( duration_fields const &f,
+		                                Duration &result ) noexcept {
+			std::int64_t secs = f.seconds;
+			if( f.years > INT64_MAX / seconds_per_year ||
+			    f.months > INT64_MAX / seconds_per_month ||
+			    !checked_add( secs, f.years * seconds_per_year, secs ) ||
+			    !checked_add( secs, f.months * seconds_per_month, secs ) ) {
+				return false;
+			}
+			std::int64_t count = 0;
+			if( !seconds_to<Duration>( secs, f.nanoseconds, count ) ) {
+				return false;
+			}
+			result = Duration( static_cast<typename Duration::rep>(
+			  f.is_negative ? -count : count ) );
+			return true;
+		}
+
+		// Add the duration to tp, with the years and months as calendar
+		// arithmetic that clamps the day to the end of the month.  Fails when the
+		// year leaves the range of std::int32_t or the result does not fit in
+		// Duration
+		template<typename Duration>
+		constexpr bool
+		try_add_duration( std::chrono::time_point<std::chrono::system_clock, Duration> tp,
+		                  duration_fields const &f, bool const subtract,
+		                  std::chrono::time_point<std::chrono::system_clock, Duration>
+		                    &result ) noexcept {
+			using time_point_t =
+			  std::chrono::time_point<std::chrono::system_clock, Duration>;
+			auto const sign = f.is_negative != subtract ? -1 : 1;
+			std::int64_t count = tp.time_since_epoch( ).count( );
+			if( f.years != 0 || f.months != 0 ) {
+				if( f.years > INT32_MAX || f.months > INT32_MAX ) {
+					return false;
+				}
+				auto const days = std::chrono::floor<date::days>( tp );
+				auto const tod = ( tp - days ).count( );
+				auto const ymd = daw::details::civil_from_days(
+				  days.time_since_epoch( ).count( ) );
+				auto const month_index = static_cast<std::int64_t>( ymd.y ) * 12 +
+				                         ( ymd.m - 1 ) +
+				                         sign * ( f.years * 12 + f.months );
+				auto const y =
+				  month_index >= 0 ? month_index / 12 : ( month_index - 11 ) / 12;
+				if( y < INT32_MIN || y > INT32_MAX ) {
+					return false;
+				}
+				auto const m = static_cast<std::uint32_t>( month_index - y * 12 ) + 1U;
+				auto const last_day = last_day_of_month( static_cast<std::int32_t>( y ), m );
+				auto const d = ymd.d < last_day ? ymd.d : last_day;
+				if( !seconds_to<Duration>(
+				      daw::details::days_from_civil( static_cast<std::int32_t>( y ), m, d ) *
+				        86'400,
+				      0, count ) ||
+				    !checked_add( count, tod, count ) ) {
+					return false;
+				}
+			}
+			auto time_part = f;
+			time_part.is_negative = false;
+			time_part.years = 0;
+			time_part.months = 0;
+			auto rest = Duration( );
+			if( !try_to_duration( time_part, rest ) ||
+			    !checked_add( count, sign * static_cast<std::int64_t>( rest.count( ) ),
+			                  count ) ) {
+				return false;
+			}
+			result = time_point_t( Duration( count ) );
+			return true;
+		}
+	} // namespace details
+
+	/// Parse an ISO 8601 duration such as P1DT2H30M or PT0.5S.  Years and
+	/// months, which have no fixed length, count as the average Gregorian
+	/// year and month like date::years and date::months.  Throws
+	/// invalid_iso8601_duration when the text is not a duration or the duration
+	/// does not fit in Duration
+	template<typename Duration = std::chrono::milliseconds>
+	constexpr Duration parse_iso8601_duration( daw::string_view const duration_str ) {
+		details::duration_fields fields{ };
+		auto result = Duration( );
+		daw::exception::precondition_check<invalid_iso8601_duration>(
+		  details::try_parse_iso8601_duration( duration_str, fields ) &&
+		  details::try_to_duration( fields, result ) );
+		return result;
+	}
+
+	template<typename Duration = std::chrono::milliseconds, size_t N>
+	constexpr Duration parse_iso8601_duration( char const ( &duration_str )[N] ) {
+		return parse_iso8601_duration<Duration>(
+		  daw::details::to_string_view( duration_str ) );
+	}
+
+	/// A half open range of time [start, end)
+	template<typename Duration = std::chrono::milliseconds>
+	struct iso8601_interval {
+		using time_point_t =
+		  std::chrono::time_point<std::chrono::system_clock, Duration>;
+
+		time_point_t start{ };
+		time_point_t end{ };
+
+		[[nodiscard]] constexpr Duration duration( ) const noexcept {
+			return end - start;
+		}
+
+		[[nodiscard]] constexpr bool contains( time_point_t const tp ) const noexcept {
+			return start <= tp && tp < end;
+		}
+	};
+
+	namespace details {
+		template<typename Duration>
+		constexpr bool try_parse_interval_timestamp(
+		  daw::string_view const str,
+		  std::chrono::time_point<std::chrono::system_clock, Duration> &tp ) noexcept {
+			timestamp_fields fields{ };
+			if( !try_parse_iso8601_timestamp( str, fields ) ) {
+				return false;
+			}
+			tp = std::chrono::time_point<std::chrono::system_clock, Duration>(
+			  Duration( to_epoch<Duration>( fields ) ) );
+			return true;
+		}
+
+		constexpr bool is_duration_text( daw::string_view const str ) noexcept {
+			return !str.empty( ) &&
+			       ( str.front( ) == 'P' || str.front( ) == 'p' || str.front( ) == '-' );
+		}
+
+		// start/end, start/duration or duration/end.  Durations are applied with
+		// calendar arithmetic for their years and months
+		template<typename Duration>
+		constexpr bool
+		try_parse_iso8601_interval( daw::string_view const str,
+		                            iso8601_interval<Duration> &result ) noexcept {
+			auto const pos = str.find_first_of( '/' );
+			if( pos == daw::string_view::npos ) {
+				return false;
+			}
+			auto const first = str.substr( 0, pos );
+			auto const second = str.substr( pos + 1U );
+			duration_fields fields{ };
+			if( is_duration_text( first ) ) {
+				if( !try_parse_iso8601_duration( first, fields ) ||
+				    !try_parse_interval_timestamp( second, result.end ) ) {
+					return false;
+				}
+				if( !try_add_duration( result.end, fields, true, result.start ) ) {
+					return false;
+				}
+			} else if( !try_parse_interval_timestamp( first, result.start ) ) {
+				return false;
+			} else if( is_duration_text( second ) ) {
+				if( !try_parse_iso8601_duration( second, fields ) ||
+				    !try_add_duration( result.start, fields, false, result.end ) ) {
+					return false;
+				}
+			} else if( !try_parse_interval_timestamp( second, result.end ) ) {
+				return false;
+			}
+			return result.start <= result.end;
+		}
+	} // namespace details
+
+	/// Parse an ISO 8601 interval, start/end, start/duration or duration/end,
+	/// such as 2017-01-02T13:14:15Z/PT1H.  Repeating intervals are not
+	/// supported
+	template<typename Duration = std::chrono::milliseconds>
+	constexpr iso8601_interval<Duration>
+	parse_iso8601_interval( daw::string_view const interval_str ) {
+		iso8601_interval<Duration> result{ };
+		daw::exception::precondition_check<invalid_iso8601_interval>(
+		  details::try_parse_iso8601_interval( interval_str, result ) );
+		return result;
+	}
+
+	template<typename Duration = std::chrono::milliseconds, size_t N>
+	constexpr iso8601_interval<Duration>
+	parse_iso8601_interval( char const ( &interval_str )[N] ) {
+		return parse_iso8601_interval<Duration>(
+		  daw::details::to_string_view( interval_str ) );
+	}
+
+	/// Parse each duration in [first, last) to out.  Invalid durations, and
+	/// those that do not fit in Duration, are written as zero
+	/// @return the number of invalid durations
+	template<typename Duration = std::chrono::milliseconds,
+	         typename ForwardIterator, typename OutputIterator>
+	constexpr std::size_t parse_iso8601_durations( ForwardIterator first,
+	                                               ForwardIterator const last,
+	                                               OutputIterator out ) {
+		std::size_t invalid_count = 0;
+		for( ; first != last; ++first ) {
+			details::duration_fields fields{ };
+			auto duration = Duration( );
+			if( details::try_parse_iso8601_duration(
+			      daw::string_view( std::data( *first ), std::size( *first ) ),
+			      fields ) &&
+			    details::try_to_duration( fields, duration ) ) {
+				*out++ = duration;
+			} else {
+				*out++ = Duration::zero( );
+				++invalid_count;
+			}
+		}
+		return invalid_count;
+	}
+
+	/// Parse each interval in [first, last) to out.  Invalid intervals are
+	/// written as empty intervals at the epoch
+	/// @return the number of invalid intervals
+	template<typename Duration = std::chrono::milliseconds,
+	         typename ForwardIterator, typename OutputIterator>
+	constexpr std::size_t parse_iso8601_intervals( ForwardIterator first,
+	                                               ForwardIterator const last,
+	                                               OutputIterator out ) {
+		std::size_t invalid_count = 0;
+		for( ; first != last; ++first ) {
+			iso8601_interval<Duration> interval{ };
+			if( !details::try_parse_iso8601_interval(
+			      daw::string_view( std::data( *first ), std::size( *first ) ),
+			      interval ) ) {
+				interval = iso8601_interval<Duration>{ };
+				++invalid_count;
+			}
+			*out++ = interval;
+		}
+		return invalid_count;
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,179 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+
+#include "daw_common.h"
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	/// The unit of a numeric epoch timestamp.  detect infers it from the digit
+	/// count: up to 10 digits are seconds, which reaches the year 2286, up to 13
+	/// milliseconds, up to 16 microseconds and up to 19 nanoseconds
+	enum class epoch_unit : std::uint8_t {
+		detect,
+		seconds,
+		milliseconds,
+		microseconds,
+		nanoseconds
+	};
+
+	namespace details {
+		constexpr epoch_unit epoch_unit_from_digits( std::size_t const digits ) noexcept {
+			if( digits <= 10 ) {
+				return epoch_unit::seconds;
+			} else if( digits <= 13 ) {
+				return epoch_unit::milliseconds;
+			} else if( digits <= 16 ) {
+				return epoch_unit::microseconds;
+			}
+			return epoch_unit::nanoseconds;
+		}
+
+		// Convert a count of Unit to Duration, rounding down, and fail when it
+		// does not fit
+		template<typename Duration, typename Unit>
+		constexpr bool epoch_to( std::int64_t const count,
+		                         std::int64_t &result ) noexcept {
+			using factor = std::ratio_divide<typename Unit::period,
+			                                 typename Duration::period>;
+			if constexpr( factor::den == 1 && factor::num > 1 ) {
+				if( count > INT64_MAX / factor::num || count < INT64_MIN / factor::num ) {
+					return false;
+				}
+			}
+			result = static_cast<std::int64_t>(
+			  std::chrono::floor<Duration>( Unit( count ) ).count( ) );
+			return true;
+		}
+
+		/// An optionally negative integer of 1 to 19 digits as a count of
+		/// Duration
+		template<typename Duration>
+		constexpr bool try_parse_epoch( daw::string_view str, epoch_unit unit,
+		                                std::int64_t &result ) noexcept {
+			bool const is_negative = !str.empty( ) && str.front( ) == '-';
+			if( is_negative ) {
+				str.remove_prefix( 1 );
+			}
+			auto const digits = str.size( );
+			if( digits == 0 || digits > 19 ) {
+				return false;
+			}
+			std::uint64_t value = 0;
+			auto const *ptr = str.data( );
+			// The leading digits that are not a multiple of 8 are scalar
+			for( auto const *const head_last = ptr + digits % 8U; ptr != head_last;
+			     ++ptr ) {
+				auto const digit =
+				  static_cast<std::uint32_t>( static_cast<unsigned char>( *ptr ) - '0' );
+				if( digit > 9 ) {
+					return false;
+				}
+				value = value * 10U + digit;
+			}
+			for( auto const *const last = str.data( ) + digits; ptr != last;
+			     ptr += 8 ) {
+				auto const chunk = daw::details::load_8chars( ptr );
+				if( !daw::details::is_8digits( chunk ) ) {
+					return false;
+				}
+				value = value * 100'000'000U + daw::details::parse_8digits( chunk );
+			}
+			if( value > static_cast<std::uint64_t>( INT64_MAX ) ) {
+				return false;
+			}
+			auto const count = is_negative ? -static_cast<std::int64_t>( value )
+			                               : static_cast<std::int64_t>( value );
+			if( unit == epoch_unit::detect ) {
+				unit = epoch_unit_from_digits( digits );
+			}
+			switch( unit ) {
+			case epoch_unit::seconds:
+				return epoch_to<Duration, std::chrono::seconds>( count, result );
+			case epoch_unit::milliseconds:
+				return epoch_to<Duration, std::chrono::milliseconds>( count, result );
+			case epoch_unit::microseconds:
+				return epoch_to<Duration, std::chrono::microseconds>( count, result );
+			default:
+				return epoch_to<Duration, std::chrono::nanoseconds>( count, result );
+			}
+		}
+
+		// ISO 8601 has a - after the year in the extended layout and a date/time
+		// separator after 8 digits in the basic one.  A numeric epoch with as
+		// many digits has a digit at both
+		constexpr bool is_iso8601_shaped( daw::string_view const str ) noexcept {
+			return ( str.size( ) > 4 && str[4] == '-' ) ||
+			       ( str.size( ) > 8 &&
+			         ( str[8] == 'T' || str[8] == 't' || str[8] == ' ' ) );
+		}
+	} // namespace details
+
+	/// Parse a decimal count since the epoch, such as 1483362855123, in the
+	/// given unit or one inferred from the number of digits
+	template<typename Duration = std::chrono::milliseconds>
+	constexpr std::chrono::time_point<std::chrono::system_clock, Duration>
+	parse_epoch_timestamp( daw::string_view const timestamp_str,
+	                       epoch_unit const unit = epoch_unit::detect ) {
+		std::int64_t result = 0;
+		daw::exception::precondition_check<invalid_epoch_timestamp>(
+		  details::try_parse_epoch<Duration>( timestamp_str, unit, result ) );
+		return std::chrono::time_point<std::chrono::system_clock, Duration>(
+		  Duration( result ) );
+	}
+
+	template<typename Duration = std::chrono::milliseconds, size_t N>
+	constexpr std::chrono::time_point<std::chrono::system_clock, Duration>
+	parse_epoch_timestamp( char const ( &timestamp_str )[N],
+	                       epoch_unit const unit = epoch_unit::detect ) {
+		return parse_epoch_timestamp<Duration>(
+		  daw::details::to_string_view( timestamp_str ), unit );
+	}
+
+	/// Parse either an ISO 8601 timestamp or a numeric epoch timestamp with
+	/// the unit inferred, telling them apart by the first 9 characters
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::milliseconds>
+	parse_any_timestamp( daw::string_view const timestamp_str ) {
+		if( details::is_iso8601_shaped( timestamp_str ) ) {
+			return parse_iso8601_timestamp( timestamp_str );
+		}
+		return parse_epoch_timestamp( timestamp_str );
+	}
+
+	template<size_t N>
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::milliseconds>
+	parse_any_timestamp( char const ( &timestamp_str )[N] ) {
+		return parse_any_timestamp( daw::details::to_string_view( timestamp_str ) );
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,419 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined( DAW_ISO8601_USE_LIBURING )
+#include <liburing.h>
+#endif
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+
+#include "daw_incremental_parsing.h"
+
+/// Sequential ingestion of large files for the line based parsers without
+/// mapping them.  A mapped file that is not in the page cache stalls the
+/// parser on each page fault, so instead the file is read into a ring of
+/// aligned buffers while the caller parses the buffers already read.  With
+/// DAW_ISO8601_USE_LIBURING defined, and liburing linked, the reads are
+/// queued with io_uring.  Otherwise a reader thread issues pread calls.
+/// POSIX only
+namespace daw::date_parsing {
+	struct file_ingest_error {};
+
+	struct file_ingest_options {
+		/// Bytes per buffer, rounded up to a multiple of alignment
+		std::size_t buffer_size = 1024U * 1024U;
+		/// Buffers in the ring.  All but the one held by the caller can be
+		/// read into at once
+		std::size_t buffer_count = 4;
+		/// Buffer alignment, a power of two.  O_DIRECT needs the logical block
+		/// size of the device
+		std::size_t alignment = 4096;
+		/// Open the file with O_DIRECT, where it is available, so the reads
+		/// bypass the page cache
+		bool direct_io = false;
+	};
+
+	namespace details {
+		struct aligned_delete {
+			std::size_t alignment;
+
+			void operator( )( char *ptr ) const noexcept {
+				::operator delete[]( ptr, std::align_val_t( alignment ) );
+			}
+		};
+
+		using aligned_buffer_t = std::unique_ptr<char[], aligned_delete>;
+
+		inline aligned_buffer_t make_aligned_buffer( std::size_t const size,
+		                                             std::size_t const alignment ) {
+			return aligned_buffer_t( static_cast<char *>( ::operator new[](
+			                           size, std::align_val_t( alignment ) ) ),
+			                         aligned_delete{ alignment } );
+		}
+
+		/// Read until size bytes are read or the end of file
+		/// @return bytes read, or -1 on error
+		inline std::ptrdiff_t pread_full( int const fd, char *buff,
+		                                  std::size_t const size,
+		                                  std::uint64_t const offset ) noexcept {
+			std::size_t result = 0;
+			while( result < size ) {
+				auto const count = ::pread( fd, buff + result, size - result,
+				                            static_cast<off_t>( offset + result ) );
+				if( count < 0 ) {
+					if( errno == EINTR ) {
+						continue;
+					}
+					return -1;
+				}
+				if( count == 0 ) {
+					break;
+				}
+				result += static_cast<std::size_t>( count );
+			}
+			return static_cast<std::ptrdiff_t>( result );
+		}
+
+		inline int open_for_ingest( std::string const &path, bool const direct_io ) {
+			int flags = O_RDONLY | O_CLOEXEC;
+#if defined( O_DIRECT )
+			if( direct_io ) {
+				flags |= O_DIRECT;
+			}
+#else
+			(void)direct_io;
+#endif
+			auto const fd = ::open( path.c_str( ), flags );
+			daw::exception::precondition_check<file_ingest_error>( fd >= 0 );
+			return fd;
+		}
+	} // namespace details
+
+	/// Reads a file front to back into a ring of buffers.  Reads into the
+	/// free buffers are in flight while the caller works on the chunk returned
+	/// by next, so parsing overlaps I/O.  Lines are not kept whole, feed the
+	/// chunks to incremental_timestamp_parser which carries a line split
+	/// across two chunks
+	class file_chunk_reader {
+		int m_fd = -1;
+		std::uint64_t m_file_size = 0;
+		std::size_t m_buffer_size = 0;
+		std::size_t m_buffer_count = 0;
+		std::size_t m_chunk_count = 0;
+		details::aligned_buffer_t m_storage;
+		std::vector<std::size_t> m_sizes;
+		// The next chunk returned to the caller.  While m_holding, the caller
+		// has the buffer of the chunk before it
+		std::size_t m_next_chunk = 0;
+		bool m_holding = false;
+#if defined( DAW_ISO8601_USE_LIBURING )
+		io_uring m_ring{ };
+		std::vector<char> m_ready;
+		std::size_t m_in_flight = 0;
+#else
+		std::mutex m_mutex{ };
+		std::condition_variable m_cv{ };
+		std::size_t m_filled = 0;
+		std::size_t m_released = 0;
+		bool m_failed = false;
+		bool m_stop = false;
+		std::thread m_reader{ };
+#endif
+
+		[[nodiscard]] char *buffer( std::size_t const chunk ) const noexcept {
+			return m_storage.get( ) + ( chunk % m_buffer_count ) * m_buffer_size;
+		}
+
+		[[nodiscard]] std::size_t chunk_size( std::size_t const chunk ) const noexcept {
+			auto const offset = static_cast<std::uint64_t>( chunk ) * m_buffer_size;
+			auto const remaining = m_file_size - offset;
+			return remaining < m_buffer_size ? static_cast<std::size_t>( remaining )
+			                                 : m_buffer_size;
+		}
+
+#if defined( DAW_ISO8601_USE_LIBURING )
+		// Read the rest of chunk into its buffer.  The whole buffer is always
+		// requested so that O_DIRECT reads stay a multiple of the block size
+		void submit_read( std::size_t const chunk ) {
+			auto const done = m_sizes[chunk % m_buffer_count];
+			io_uring_sqe *sqe = io_uring_get_sqe( &m_ring );
+			daw::exception::precondition_check<file_ingest_error>( sqe != nullptr );
+			io_uring_prep_read(
+			  sqe, m_fd, buffer( chunk ) + done,
+			  static_cast<unsigned>( m_buffer_size - done ),
+			  static_cast<std::uint64_t>( chunk ) * m_buffer_size + done );
+			io_uring_sqe_set_data(
+			  sqe, reinterpret_cast<void *>( static_cast<std::uintptr_t>( chunk ) ) );
+			++m_in_flight;
+		}
+
+		void submit( ) {
+			daw::exception::precondition_check<file_ingest_error>(
+			  io_uring_submit( &m_ring ) >= 0 );
+		}
+
+		// Wait for one completion, queueing the rest of a short read
+		void reap( ) {
+			io_uring_cqe *cqe = nullptr;
+			int wait_result = io_uring_wait_cqe( &m_ring, &cqe );
+			while( wait_result == -EINTR ) {
+				wait_result = io_uring_wait_cqe( &m_ring, &cqe );
+			}
+			daw::exception::precondition_check<file_ingest_error>( wait_result == 0 );
+			auto const chunk = static_cast<std::size_t>(
+			  reinterpret_cast<std::uintptr_t>( io_uring_cqe_get_data( cqe ) ) );
+			auto const res = cqe->res;
+			io_uring_cqe_seen( &m_ring, cqe );
+			--m_in_flight;
+			auto const slot = chunk % m_buffer_count;
+			if( res == -EINTR or res == -EAGAIN ) {
+				submit_read( chunk );
+				submit( );
+				return;
+			}
+			daw::exception::precondition_check<file_ingest_error>( res >= 0 );
+			m_sizes[slot] += static_cast<std::size_t>( res );
+			if( res > 0 and m_sizes[slot] < chunk_size( chunk ) ) {
+				submit_read( chunk );
+				submit( );
+				return;
+			}
+			m_ready[slot] = 1;
+		}
+
+		void start( ) {
+			daw::exception::precondition_check<file_ingest_error>(
+			  io_uring_queue_init( static_cast<unsigned>( m_buffer_count ), &m_ring,
+			                       0 ) == 0 );
+			m_ready.resize( m_buffer_count );
+			for( std::size_t chunk = 0;
+			     chunk < m_buffer_count and chunk < m_chunk_count; ++chunk ) {
+				submit_read( chunk );
+			}
+			submit( );
+		}
+
+		void stop( ) noexcept {
+			// The kernel may still write to the buffers until the reads complete
+			while( m_in_flight > 0 ) {
+				io_uring_cqe *cqe = nullptr;
+				auto const wait_result = io_uring_wait_cqe( &m_ring, &cqe );
+				if( wait_result == -EINTR ) {
+					continue;
+				}
+				if( wait_result != 0 ) {
+					break;
+				}
+				io_uring_cqe_seen( &m_ring, cqe );
+				--m_in_flight;
+			}
+			io_uring_queue_exit( &m_ring );
+		}
+#else
+		void read_chunks( ) {
+			for( std::size_t chunk = 0; chunk < m_chunk_count; ++chunk ) {
+				{
+					auto lock = std::unique_lock<std::mutex>( m_mutex );
+					m_cv.wait( lock, [&] {
+						return m_stop or chunk - m_released < m_buffer_count;
+					} );
+					if( m_stop ) {
+						return;
+					}
+				}
+				// The whole buffer is always requested so that O_DIRECT reads stay a
+				// multiple of the block size
+				auto const size =
+				  details::pread_full( m_fd, buffer( chunk ), m_buffer_size,
+				                       static_cast<std::uint64_t>( chunk ) * m_buffer_size );
+				{
+					auto const lock = std::lock_guard<std::mutex>( m_mutex );
+					if( size < 0 ) {
+						m_failed = true;
+					} else {
+						m_sizes[chunk % m_buffer_count] = static_cast<std::size_t>( size );
+						++m_filled;
+					}
+				}
+				m_cv.notify_all( );
+				if( size < 0 ) {
+					return;
+				}
+			}
+		}
+
+		void start( ) {
+			if( m_chunk_count > 0 ) {
+				m_reader = std::thread( [this] { read_chunks( ); } );
+			}
+		}
+
+		void stop( ) noexcept {
+			{
+				auto const lock = std::lock_guard<std::mutex>( m_mutex );
+				m_stop = true;
+			}
+			m_cv.notify_all( );
+			if( m_reader.joinable( ) ) {
+				m_reader.join( );
+			}
+		}
+#endif
+
+	public:
+		explicit file_chunk_reader( std::string const &path,
+		                            file_ingest_options const &options = { } )
+		  : m_fd( details::open_for_ingest( path, options.direct_io ) ) {
+			try {
+				daw::exception::precondition_check<file_ingest_error>(
+				  options.buffer_count > 1 and options.alignment > 0 and
+				  ( options.alignment & ( options.alignment - 1U ) ) == 0 );
+				struct stat st { };
+				daw::exception::precondition_check<file_ingest_error>(
+				  ::fstat( m_fd, &st ) == 0 );
+				m_file_size = static_cast<std::uint64_t>( st.st_size );
+				m_buffer_size = ( ( options.buffer_size + options.alignment - 1U ) /
+				                  options.alignment ) *
+				                options.alignment;
+				if( m_buffer_size == 0 ) {
+					m_buffer_size = options.alignment;
+				}
+				m_buffer_count = options.buffer_count;
+				m_chunk_count = static_cast<std::size_t>(
+				  ( m_file_size + m_buffer_size - 1U ) / m_buffer_size );
+				m_storage = details::make_aligned_buffer(
+				  m_buffer_size * m_buffer_count, options.alignment );
+				m_sizes.resize( m_buffer_count );
+#if defined( POSIX_FADV_SEQUENTIAL )
+				(void)::posix_fadvise( m_fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+#endif
+				start( );
+			} catch( ... ) {
+				::close( m_fd );
+				throw;
+			}
+		}
+
+		file_chunk_reader( file_chunk_reader const & ) = delete;
+		file_chunk_reader &operator=( file_chunk_reader const & ) = delete;
+
+		~file_chunk_reader( ) {
+			stop( );
+			::close( m_fd );
+		}
+
+		/// The next chunk of the file, in order.  It is valid until the following
+		/// call, which gives its buffer back to the reader.  Empty at the end of
+		/// the file
+		daw::string_view next( ) {
+#if defined( DAW_ISO8601_USE_LIBURING )
+			if( m_holding ) {
+				auto const released = m_next_chunk - 1U;
+				m_holding = false;
+				m_ready[released % m_buffer_count] = 0;
+				m_sizes[released % m_buffer_count] = 0;
+				if( released + m_buffer_count < m_chunk_count ) {
+					submit_read( released + m_buffer_count );
+					submit( );
+				}
+			}
+			if( m_next_chunk == m_chunk_count ) {
+				return { };
+			}
+			auto const slot = m_next_chunk % m_buffer_count;
+			while( m_ready[slot] == 0 ) {
+				reap( );
+			}
+#else
+			auto lock = std::unique_lock<std::mutex>( m_mutex );
+			if( m_holding ) {
+				m_holding = false;
+				++m_released;
+				m_cv.notify_all( );
+			}
+			if( m_next_chunk == m_chunk_count ) {
+				return { };
+			}
+			m_cv.wait( lock, [&] { return m_failed or m_filled > m_next_chunk; } );
+			daw::exception::precondition_check<file_ingest_error>( m_filled >
+			                                                       m_next_chunk );
+			auto const slot = m_next_chunk % m_buffer_count;
+#endif
+			auto const *first = buffer( m_next_chunk );
+			++m_next_chunk;
+			m_holding = true;
+			return daw::string_view( first, m_sizes[slot] );
+		}
+
+		[[nodiscard]] std::uint64_t file_size( ) const noexcept {
+			return m_file_size;
+		}
+
+		[[nodiscard]] std::size_t buffer_size( ) const noexcept {
+			return m_buffer_size;
+		}
+	};
+
+	struct file_ingest_result {
+		std::size_t timestamp_count = 0;
+		std::size_t error_count = 0;
+	};
+
+	/// Parse a file of newline separated ISO 8601 timestamps, calling
+	/// handler( time_point ) for each in file order while the rest of the file
+	/// is read.  Lines that are not timestamps are counted as errors
+	template<typename Duration = std::chrono::milliseconds, typename Handler>
+	file_ingest_result
+	ingest_iso8601_file( std::string const &path, Handler &&handler,
+	                     file_ingest_options const &options = { } ) {
+		file_chunk_reader reader( path, options );
+		auto parser = incremental_timestamp_parser<Duration>( );
+		file_ingest_result result{ };
+		for( auto chunk = reader.next( ); not chunk.empty( );
+		     chunk = reader.next( ) ) {
+			result.timestamp_count += parser.feed( chunk, handler );
+		}
+		result.timestamp_count += parser.finish( handler );
+		result.error_count = parser.error_count( );
+		return result;
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,269 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+
+#include "daw_common.h"
+#include "daw_date_formatting.h"
+#include "daw_date_parsing.h"
+#include "daw_log_timestamp_parsing.h"
+
+namespace daw::date_parsing {
+	/// Size of an IMF-fixdate, Sun, 06 Nov 1994 08:49:37 GMT
+	inline constexpr std::size_t http_date_size = 29;
+
+	namespace details {
+		constexpr std::uint32_t weekday_name_hash( std::uint32_t const packed ) noexcept {
+			return ( ( packed * 23U ) >> 14U ) & 0x7U;
+		}
+
+		struct weekday_name_entry {
+			std::uint32_t packed;
+			std::uint8_t weekday;
+		};
+
+		// Indexed by weekday_name_hash, a perfect hash of the 7 lower case
+		// English weekday abbreviations.  Weekdays count from Sunday as 0
+		inline constexpr weekday_name_entry weekday_name_table[8] = {
+		  { pack_abbreviation( "mon" ), 1 },
+		  { pack_abbreviation( "thu" ), 4 },
+		  { pack_abbreviation( "sun" ), 0 },
+		  { pack_abbreviation( "sat" ), 6 },
+		  { pack_abbreviation( "wed" ), 3 },
+		  { pack_abbreviation( "fri" ), 5 },
+		  { pack_abbreviation( "tue" ), 2 },
+		  { 0, 0xFF } };
+
+		/// Weekday, 0-6 from Sunday, of a case insensitive English weekday
+		/// abbreviation or 0xFF when name is not one
+		constexpr std::uint8_t parse_weekday_name( char const *name ) noexcept {
+			auto const packed = pack_abbreviation( name );
+			auto const &entry = weekday_name_table[weekday_name_hash( packed )];
+			return entry.packed == packed ? entry.weekday : 0xFF;
+		}
+
+		constexpr std::uint32_t weekday_from_days( std::int64_t const days ) noexcept {
+			// 1970-01-01 was a Thursday
+			return static_cast<std::uint32_t>( ( days % 7 + 11 ) % 7 );
+		}
+
+		inline constexpr char http_weekday_names[] = "SunMonTueWedThuFriSat";
+		inline constexpr char http_month_names[] =
+		  "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+		constexpr bool consume_char( daw::string_view &str, char const c ) noexcept {
+			if( str.empty( ) || str.front( ) != c ) {
+				return false;
+			}
+			str.remove_prefix( 1 );
+			return true;
+		}
+
+		// The zone of an RFC 2822 date, GMT, UT or a numeric offset, and the
+		// RFC 1123 UTC and Z spellings
+		constexpr bool try_parse_http_zone( daw::string_view str,
+		                                    std::int16_t &offset ) noexcept {
+			if( str == daw::string_view( "GMT" ) || str == daw::string_view( "UT" ) ||
+			    str == daw::string_view( "UTC" ) ) {
+				offset = 0;
+				return true;
+			}
+			// try_parse_offset treats no offset as UTC, but the zone is required
+			return !str.empty( ) && try_parse_offset( str, offset ) &&
+			       str.empty( );
+		}
+
+		template<bool ValidateWeekday>
+		constexpr bool try_parse_http_date( daw::string_view str,
+		                                    std::int64_t &secs ) noexcept {
+			std::uint8_t weekday = 0xFF;
+			if( str.size( ) > 4 && str[3] == ',' ) {
+				if constexpr( ValidateWeekday ) {
+					weekday = parse_weekday_name( str.data( ) );
+					if( weekday == 0xFF ) {
+						return false;
+					}
+				}
+				str.remove_prefix( 4 );
+				skip_optional( str, ' ' );
+			}
+			std::uint32_t d = 0;
+			std::uint32_t y = 0;
+			std::uint32_t h = 0;
+			std::uint32_t mi = 0;
+			std::uint32_t s = 0;
+			// RFC 1123 requires 2 day digits, RFC 2822 allows 1
+			auto const day_digits =
+			  str.size( ) > 1 && daw::details::is_digit( str[1] ) ? 2U : 1U;
+			if( !try_consume_unsigned( str, day_digits, d ) ||
+			    !consume_char( str, ' ' ) || str.size( ) < 4 ) {
+				return false;
+			}
+			auto const mo = parse_month_name( str.data( ) );
+			str.remove_prefix( 3 );
+			if( mo == 0 || !consume_char( str, ' ' ) ||
+			    !try_consume_unsigned( str, 4, y ) || !consume_char( str, ' ' ) ||
+			    !try_consume_unsigned( str, 2, h ) || h > 23 ||
+			    !consume_char( str, ':' ) || !try_consume_unsigned( str, 2, mi ) ||
+			    mi > 59 ) {
+				return false;
+			}
+			if( consume_char( str, ':' ) &&
+			    ( !try_consume_unsigned( str, 2, s ) || s > 60 ) ) {
+				return false;
+			}
+			std::int16_t offset = 0;
+			if( !consume_char( str, ' ' ) || !try_parse_http_zone( str, offset ) ||
+			    d < 1 || d > last_day_of_month( static_cast<std::int32_t>( y ), mo ) ) {
+				return false;
+			}
+			auto const days =
+			  daw::details::days_from_civil( static_cast<std::int32_t>( y ), mo, d );
+			if constexpr( ValidateWeekday ) {
+				if( weekday != 0xFF && weekday != weekday_from_days( days ) ) {
+					return false;
+				}
+			}
+			secs = days * 86400 + static_cast<std::int64_t>( h ) * 3600 +
+			       static_cast<std::int64_t>( mi ) * 60 +
+			       static_cast<std::int64_t>( s ) -
+			       static_cast<std::int64_t>( offset ) * 60;
+			return true;
+		}
+	} // namespace details
+
+	/// Parse an HTTP-date in the IMF-fixdate form of RFC 7231/1123,
+	/// Sun, 06 Nov 1994 08:49:37 GMT, or the more general RFC 2822 form with an
+	/// optional weekday, a one digit day, optional seconds or a numeric zone.
+	/// The weekday, when present, must agree with the date unless
+	/// ValidateWeekday is false, in which case it is skipped unread
+	template<bool ValidateWeekday = true>
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::seconds>
+	parse_http_date( daw::string_view const date_str ) {
+		std::int64_t secs = 0;
+		daw::exception::precondition_check<invalid_http_date>(
+		  details::try_parse_http_date<ValidateWeekday>( date_str, secs ) );
+		return std::chrono::time_point<std::chrono::system_clock,
+		                               std::chrono::seconds>(
+		  std::chrono::seconds( secs ) );
+	}
+
+	template<bool ValidateWeekday = true, size_t N>
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::seconds>
+	parse_http_date( char const ( &date_str )[N] ) {
+		return parse_http_date<ValidateWeekday>(
+		  daw::details::to_string_view( date_str ) );
+	}
+} // namespace daw::date_parsing
+
+namespace daw::date_formatting {
+	/// Write the IMF-fixdate of tp, Sun, 06 Nov 1994 08:49:37 GMT, to
+	/// out[0, http_date_size).  The names come from tables and the digits
+	/// from integer arithmetic, with no locale involved
+	template<typename Duration>
+	constexpr void fmt_http_date(
+	  std::chrono::time_point<std::chrono::system_clock, Duration> const &tp,
+	  char *out ) noexcept {
+		auto const secs = static_cast<std::int64_t>(
+		  std::chrono::floor<std::chrono::seconds>( tp ).time_since_epoch( ).count( ) );
+		auto days = secs / 86400;
+		auto sod = secs % 86400;
+		if( sod < 0 ) {
+			sod += 86400;
+			--days;
+		}
+		auto const ymd = daw::details::civil_from_days( days );
+		auto const weekday = daw::date_parsing::details::weekday_from_days( days );
+		auto const s = static_cast<std::uint32_t>( sod );
+		auto const *const wd_name =
+		  daw::date_parsing::details::http_weekday_names + weekday * 3U;
+		auto const *const mo_name =
+		  daw::date_parsing::details::http_month_names + ( ymd.m - 1U ) * 3U;
+		out[0] = wd_name[0];
+		out[1] = wd_name[1];
+		out[2] = wd_name[2];
+		out[3] = ',';
+		out[4] = ' ';
+		impl::put_2digits( out + 5, ymd.d );
+		out[7] = ' ';
+		out[8] = mo_name[0];
+		out[9] = mo_name[1];
+		out[10] = mo_name[2];
+		out[11] = ' ';
+		impl::put_4digits( out + 12, static_cast<std::uint32_t>( ymd.y ) );
+		out[16] = ' ';
+		impl::put_2digits( out + 17, s / 3600U );
+		out[19] = ':';
+		impl::put_2digits( out + 20, ( s / 60U ) % 60U );
+		out[22] = ':';
+		impl::put_2digits( out + 23, s % 60U );
+		out[25] = ' ';
+		out[26] = 'G';
+		out[27] = 'M';
+		out[28] = 'T';
+	}
+
+	template<typename Duration>
+	std::string fmt_http_date(
+	  std::chrono::time_point<std::chrono::system_clock, Duration> const &tp ) {
+		std::string result( daw::date_parsing::http_date_size, '\0' );
+		fmt_http_date( tp, result.data( ) );
+		return result;
+	}
+
+	/// Formats HTTP-dates with a one entry cache keyed on the second, as a
+	/// Date header only changes once a second.  Not synchronized, use one per
+	/// thread
+	class http_date_cache {
+		std::int64_t m_second = 0;
+		bool m_is_set = false;
+		char m_buffer[daw::date_parsing::http_date_size]{ };
+
+	public:
+		/// The HTTP-date of tp.  The view is valid until the next call
+		template<typename Duration>
+		daw::string_view
+		operator( )( std::chrono::time_point<std::chrono::system_clock, Duration> const
+		               &tp ) noexcept {
+			auto const second = static_cast<std::int64_t>(
+			  std::chrono::floor<std::chrono::seconds>( tp ).time_since_epoch( ).count( ) );
+			if( !m_is_set || second != m_second ) {
+				fmt_http_date( tp, m_buffer );
+				m_second = second;
+				m_is_set = true;
+			}
+			return daw::string_view( m_buffer, daw::date_parsing::http_date_size );
+		}
+	};
+} // namespace daw::date_formatting
@@ -0,0 +1,167 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+#include <daw/daw_string_view.h>
+
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	/// Parses newline separated timestamps from a byte stream delivered in
+	/// arbitrary chunks, such as socket reads or ring buffer segments.
+	/// Timestamps that lie entirely within a chunk are parsed in place.  Only
+	/// the bytes of a timestamp that straddles a chunk boundary are carried to
+	/// the next call, in a fixed buffer, so the stream is never linearized.
+	/// Records that are not valid timestamps, or are longer than
+	/// max_record_size, are skipped and counted
+	template<typename Duration = std::chrono::milliseconds>
+	class incremental_timestamp_parser {
+	public:
+		using time_point_t =
+		  std::chrono::time_point<std::chrono::system_clock, Duration>;
+
+		/// Longest record that is parsed, not counting a trailing CR.  This is an
+		/// extended timestamp with a U+2212 offset sign and 20 fraction digits.
+		/// Longer records are errors whether or not they straddle a chunk, so
+		/// the result does not depend on where the stream is split
+		static constexpr std::size_t max_record_size = 48;
+
+	private:
+		char m_partial[max_record_size + 1U]{ };
+		std::size_t m_partial_size = 0;
+		bool m_partial_overflow = false;
+		std::size_t m_error_count = 0;
+
+		template<typename Handler>
+		std::size_t emit( daw::string_view record, Handler &handler ) {
+			if( not record.empty( ) and record.back( ) == '\r' ) {
+				record.remove_suffix( 1 );
+			}
+			if( record.empty( ) ) {
+				return 0;
+			}
+			details::timestamp_fields fields{ };
+			if( record.size( ) > max_record_size or
+			    not details::try_parse_iso8601_timestamp( record, fields ) ) {
+				++m_error_count;
+				return 0;
+			}
+			handler( time_point_t( Duration( details::to_epoch<Duration>( fields ) ) ) );
+			return 1;
+		}
+
+		void carry( char const *first, std::size_t const size ) noexcept {
+			if( m_partial_overflow or m_partial_size + size > sizeof( m_partial ) ) {
+				m_partial_overflow = true;
+				return;
+			}
+			std::memcpy( m_partial + m_partial_size, first, size );
+			m_partial_size += size;
+		}
+
+		template<typename Handler>
+		std::size_t flush_partial( Handler &handler ) {
+			std::size_t result = 0;
+			if( m_partial_overflow ) {
+				++m_error_count;
+			} else {
+				result = emit( daw::string_view( m_partial, m_partial_size ), handler );
+			}
+			m_partial_size = 0;
+			m_partial_overflow = false;
+			return result;
+		}
+
+	public:
+		incremental_timestamp_parser( ) = default;
+
+		/// Consume the next chunk of the stream, calling handler( time_point )
+		/// for each timestamp completed by it
+		/// @return number of timestamps emitted
+		template<typename Handler>
+		std::size_t feed( daw::string_view chunk, Handler &&handler ) {
+			std::size_t result = 0;
+			while( not chunk.empty( ) ) {
+				auto const *nl = static_cast<char const *>(
+				  std::memchr( chunk.data( ), '\n', chunk.size( ) ) );
+				if( nl == nullptr ) {
+					carry( chunk.data( ), chunk.size( ) );
+					break;
+				}
+				auto const size = static_cast<std::size_t>( nl - chunk.data( ) );
+				if( m_partial_size > 0 or m_partial_overflow ) {
+					carry( chunk.data( ), size );
+					result += flush_partial( handler );
+				} else {
+					result += emit( chunk.substr( 0, size ), handler );
+				}
+				chunk.remove_prefix( size + 1U );
+			}
+			return result;
+		}
+
+		template<typename Handler>
+		std::size_t feed( char const *data, std::size_t const size,
+		                  Handler &&handler ) {
+			return feed( daw::string_view( data, size ), handler );
+		}
+
+		/// Scatter/gather input.  IoVec is any type with iov_base and iov_len
+		/// members, such as the POSIX struct iovec filled in by readv/recvmsg
+		template<typename IoVec, typename Handler>
+		std::size_t feed( IoVec const *iov, std::size_t const count,
+		                  Handler &&handler ) {
+			std::size_t result = 0;
+			for( std::size_t n = 0; n < count; ++n ) {
+				result += feed( daw::string_view(
+				                  static_cast<char const *>( iov[n].iov_base ),
+				                  static_cast<std::size_t>( iov[n].iov_len ) ),
+				                handler );
+			}
+			return result;
+		}
+
+		/// End of stream, parses a final timestamp that has no newline
+		template<typename Handler>
+		std::size_t finish( Handler &&handler ) {
+			if( m_partial_size == 0 and not m_partial_overflow ) {
+				return 0;
+			}
+			return flush_partial( handler );
+		}
+
+		/// Bytes of an incomplete timestamp carried to the next feed
+		[[nodiscard]] std::size_t pending_size( ) const noexcept {
+			return m_partial_size;
+		}
+
+		[[nodiscard]] std::size_t error_count( ) const noexcept {
+			return m_error_count;
+		}
+	};
+} // namespace daw::date_parsing
@@ -0,0 +1,118 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+#include <daw/daw_string_view.h>
+#include <daw/json/daw_json_link.h>
+
+#include "daw_date_formatting.h"
+#include "daw_date_parsing.h"
+
+/// Mappings for daw_json_link that parse timestamps in place from the JSON
+/// document and serialize them with the fixed layout formatter, so no
+/// std::string is created in either direction
+namespace daw::date_parsing::json {
+	using timestamp_t =
+	  std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+	/// Constructor for json_date, called with the raw string member
+	struct iso8601_timestamp_constructor {
+		constexpr timestamp_t operator( )( ) const noexcept {
+			return timestamp_t{ };
+		}
+
+		constexpr timestamp_t operator( )( char const *ptr,
+		                                   std::size_t const sz ) const {
+			return ::daw::date_parsing::parse_iso8601_timestamp(
+			  daw::string_view( ptr, sz ) );
+		}
+	};
+
+	/// Constructor for json_date restricted to YYYY-MM-DDTHH:MM:SS.sssZ
+	struct javascript_timestamp_constructor {
+		constexpr timestamp_t operator( )( ) const noexcept {
+			return timestamp_t{ };
+		}
+
+		constexpr timestamp_t operator( )( char const *ptr,
+		                                   std::size_t const sz ) const {
+			return ::daw::date_parsing::parse_javascript_timestamp(
+			  daw::string_view( ptr, sz ) );
+		}
+	};
+
+	/// FromJsonConverter for json_custom
+	struct iso8601_timestamp_from_converter {
+		constexpr timestamp_t operator( )( std::string_view sv ) const {
+			return ::daw::date_parsing::parse_iso8601_timestamp(
+			  daw::string_view( sv.data( ), sv.size( ) ) );
+		}
+	};
+
+	/// FromJsonConverter for json_custom restricted to the Javascript layout
+	struct javascript_timestamp_from_converter {
+		constexpr timestamp_t operator( )( std::string_view sv ) const {
+			return ::daw::date_parsing::parse_javascript_timestamp(
+			  daw::string_view( sv.data( ), sv.size( ) ) );
+		}
+	};
+
+	/// ToJsonConverter for json_custom, writes YYYY-MM-DDTHH:MM:SS.sssZ
+	/// directly to the serializer's output
+	struct javascript_timestamp_to_converter {
+		template<typename OutputIterator>
+		constexpr OutputIterator operator( )( OutputIterator it,
+		                                      timestamp_t const &tp ) const {
+			return ::daw::date_formatting::fmt_javascript_timestamp( tp, it );
+		}
+	};
+
+	/// A string member holding any ISO 8601 timestamp, serialized in the
+	/// Javascript layout
+	template<JSONNAMETYPE Name>
+	using json_iso8601_timestamp =
+	  daw::json::json_custom<Name, timestamp_t, iso8601_timestamp_from_converter,
+	                         javascript_timestamp_to_converter>;
+
+	/// A string member holding a Javascript layout timestamp
+	template<JSONNAMETYPE Name>
+	using json_javascript_timestamp =
+	  daw::json::json_custom<Name, timestamp_t,
+	                         javascript_timestamp_from_converter,
+	                         javascript_timestamp_to_converter>;
+
+	/// json_date mappings for use where daw_json_link's own date serialization
+	/// is wanted
+	template<JSONNAMETYPE Name>
+	using json_iso8601_date =
+	  daw::json::json_date<Name, timestamp_t, iso8601_timestamp_constructor>;
+
+	template<JSONNAMETYPE Name>
+	using json_javascript_date =
+	  daw::json::json_date<Name, timestamp_t, javascript_timestamp_constructor>;
+} // namespace daw::date_parsing::json
@@ -0,0 +1,254 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <daw/daw_string_view.h>
+
+#include "daw_common.h"
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	/// The layout of a timestamp's text as detected without parsing it
+	struct timestamp_shape {
+		enum class layout_t : std::uint8_t { unknown, extended, basic };
+
+		layout_t layout = layout_t::unknown;
+		// Position one past the last fraction digit, where the offset starts
+		std::uint8_t offset_pos = 0;
+
+		[[nodiscard]] constexpr std::size_t date_size( ) const noexcept {
+			return layout == layout_t::extended ? 10U : 8U;
+		}
+
+		[[nodiscard]] constexpr std::size_t time_size( ) const noexcept {
+			return layout == layout_t::extended ? 8U : 6U;
+		}
+	};
+
+	namespace details {
+		constexpr bool all_digits( daw::string_view const str, std::size_t pos,
+		                           std::size_t const last ) noexcept {
+			for( ; pos < last; ++pos ) {
+				if( not daw::details::is_digit( str[pos] ) ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr bool is_timestamp_separator( char const c ) noexcept {
+			return c == 'T' or c == 't' or c == ' ';
+		}
+
+		// Only the positions of digits and punctuation are checked; the field
+		// values are left to the parse
+		constexpr timestamp_shape
+		detect_shape( daw::string_view const ts ) noexcept {
+			using layout_t = timestamp_shape::layout_t;
+			timestamp_shape result{ };
+			std::size_t pos = 0;
+			if( ts.size( ) >= 19 and ts[4] == '-' and ts[7] == '-' and
+			    is_timestamp_separator( ts[10] ) and ts[13] == ':' and
+			    ts[16] == ':' and all_digits( ts, 0, 4 ) and all_digits( ts, 5, 7 ) and
+			    all_digits( ts, 8, 10 ) and all_digits( ts, 11, 13 ) and
+			    all_digits( ts, 14, 16 ) and all_digits( ts, 17, 19 ) ) {
+				result.layout = layout_t::extended;
+				pos = 19;
+			} else if( ts.size( ) >= 15 and is_timestamp_separator( ts[8] ) and
+			           all_digits( ts, 0, 8 ) and all_digits( ts, 9, 15 ) ) {
+				result.layout = layout_t::basic;
+				pos = 15;
+			} else {
+				return result;
+			}
+			// Only the fraction separator parse_iso8601_timestamp accepts
+			if( pos < ts.size( ) and ts[pos] == '.' ) {
+				++pos;
+				while( pos < ts.size( ) and daw::details::is_digit( ts[pos] ) ) {
+					++pos;
+				}
+			}
+			if( pos > 0xFFU ) {
+				return timestamp_shape{ };
+			}
+			result.offset_pos = static_cast<std::uint8_t>( pos );
+			return result;
+		}
+
+		constexpr int compare_bytes( daw::string_view const lhs,
+		                             daw::string_view const rhs, std::size_t pos,
+		                             std::size_t const last ) noexcept {
+			for( ; pos < last; ++pos ) {
+				if( lhs[pos] != rhs[pos] ) {
+					return static_cast<unsigned char>( lhs[pos] ) <
+					           static_cast<unsigned char>( rhs[pos] )
+					         ? -1
+					         : 1;
+				}
+			}
+			return 0;
+		}
+	} // namespace details
+
+	/// A timestamp held as a view of its text.  It is parsed only when the numeric value is first needed and
+	/// the result is cached.  Two values with the same shape and the same
+	/// offset text are compared byte by byte, skipping the date/time and
+	/// fraction separators and the fraction digits below a millisecond, without
+	/// parsing either.  The text must outlive the
+	/// value, and the cache is not synchronized for concurrent first use
+	class lazy_timestamp {
+	public:
+		using time_point_t =
+		  std::chrono::time_point<std::chrono::system_clock,
+		                          std::chrono::milliseconds>;
+
+	private:
+		daw::string_view m_text{ };
+		timestamp_shape m_shape{ };
+		mutable bool m_is_parsed = false;
+		mutable time_point_t m_value{ };
+
+		[[nodiscard]] constexpr bool
+		is_textually_comparable( lazy_timestamp const &rhs ) const noexcept {
+			if( m_shape.layout == timestamp_shape::layout_t::unknown or
+			    m_shape.layout != rhs.m_shape.layout or
+			    m_shape.offset_pos != rhs.m_shape.offset_pos ) {
+				return false;
+			}
+			return m_text.substr( m_shape.offset_pos ) ==
+			       rhs.m_text.substr( rhs.m_shape.offset_pos );
+		}
+
+		[[nodiscard]] constexpr int
+		compare_text( lazy_timestamp const &rhs ) const noexcept {
+			auto const date_size = m_shape.date_size( );
+			auto const time_end = date_size + 1U + m_shape.time_size( );
+			if( auto const r =
+			      details::compare_bytes( m_text, rhs.m_text, 0, date_size );
+			    r != 0 ) {
+				return r;
+			}
+			if( auto const r = details::compare_bytes( m_text, rhs.m_text,
+			                                           date_size + 1U, time_end );
+			    r != 0 ) {
+				return r;
+			}
+			// Only the millisecond digits of the fraction, as value( ) keeps
+			auto const fraction_end = time_end + 4U < m_shape.offset_pos
+			                            ? time_end + 4U
+			                            : std::size_t{ m_shape.offset_pos };
+			return details::compare_bytes( m_text, rhs.m_text, time_end + 1U,
+			                               fraction_end );
+		}
+
+	public:
+		constexpr lazy_timestamp( ) noexcept = default;
+
+		explicit constexpr lazy_timestamp( daw::string_view const text ) noexcept
+		  : m_text( text )
+		  , m_shape( details::detect_shape( text ) ) {}
+
+		[[nodiscard]] constexpr daw::string_view text( ) const noexcept {
+			return m_text;
+		}
+
+		[[nodiscard]] constexpr timestamp_shape shape( ) const noexcept {
+			return m_shape;
+		}
+
+		[[nodiscard]] constexpr bool is_parsed( ) const noexcept {
+			return m_is_parsed;
+		}
+
+		/// The parsed time point.  Throws invalid_iso8601_timestamp when the text
+		/// is not a timestamp.  Text with an unknown shape, such as the basic
+		/// layout without a date/time separator, is still parsed
+		[[nodiscard]] time_point_t value( ) const {
+			if( not m_is_parsed ) {
+				details::timestamp_fields fields{ };
+				daw::exception::precondition_check<invalid_iso8601_timestamp>(
+				  details::try_parse_iso8601_timestamp( m_text, fields ) );
+				m_value = time_point_t( std::chrono::milliseconds(
+				  details::to_epoch<std::chrono::milliseconds>( fields ) ) );
+				m_is_parsed = true;
+			}
+			return m_value;
+		}
+
+		/// Three way comparison, negative when *this is earlier than rhs
+		[[nodiscard]] int compare( lazy_timestamp const &rhs ) const {
+			if( is_textually_comparable( rhs ) ) {
+				return compare_text( rhs );
+			}
+			auto const lhs_value = value( );
+			auto const rhs_value = rhs.value( );
+			return lhs_value < rhs_value ? -1 : ( rhs_value < lhs_value ? 1 : 0 );
+		}
+
+		[[nodiscard]] int compare( time_point_t const &rhs ) const {
+			auto const lhs_value = value( );
+			return lhs_value < rhs ? -1 : ( rhs < lhs_value ? 1 : 0 );
+		}
+	};
+
+	template<typename T>
+	auto operator==( lazy_timestamp const &lhs, T const &rhs )
+	  -> decltype( lhs.compare( rhs ) == 0 ) {
+		return lhs.compare( rhs ) == 0;
+	}
+
+	template<typename T>
+	auto operator!=( lazy_timestamp const &lhs, T const &rhs )
+	  -> decltype( lhs.compare( rhs ) != 0 ) {
+		return lhs.compare( rhs ) != 0;
+	}
+
+	template<typename T>
+	auto operator<( lazy_timestamp const &lhs, T const &rhs )
+	  -> decltype( lhs.compare( rhs ) < 0 ) {
+		return lhs.compare( rhs ) < 0;
+	}
+
+	template<typename T>
+	auto operator<=( lazy_timestamp const &lhs, T const &rhs )
+	  -> decltype( lhs.compare( rhs ) <= 0 ) {
+		return lhs.compare( rhs ) <= 0;
+	}
+
+	template<typename T>
+	auto operator>( lazy_timestamp const &lhs, T const &rhs )
+	  -> decltype( lhs.compare( rhs ) > 0 ) {
+		return lhs.compare( rhs ) > 0;
+	}
+
+	template<typename T>
+	auto operator>=( lazy_timestamp const &lhs, T const &rhs )
+	  -> decltype( lhs.compare( rhs ) >= 0 ) {
+		return lhs.compare( rhs ) >= 0;
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,420 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+
+#include "daw_date_parsing.h"
+#include "daw_log_search.h"
+
+/// A sparse sidecar index of a log sorted by a leading timestamp.  It holds
+/// an (offset, epoch ms) entry every line_stride lines or byte_stride bytes.
+///
+/// File layout, all integers little endian
+///   payload      blocks of up to block_size entries.  The first entry of a
+///                block is in the block table, the rest are LEB128 varints of
+///                the offset delta and the zigzag encoded ms delta
+///   block table  block_count * { u64 offset, i64 ms, u64 payload position }
+///   footer       u64 line_stride, u64 byte_stride, u64 table position,
+///                u64 block_count, u64 entry_count, u64 indexed size,
+///                u64 lines since the last entry, 8 byte magic
+/// The block table is fixed width so a query on a mapped index is a binary
+/// search touching O(log n) pages followed by decoding a single block
+namespace daw::date_parsing {
+	struct invalid_time_index {};
+
+	struct time_index_options {
+		std::uint64_t line_stride = 1024;
+		std::uint64_t byte_stride = 64U * 1024U;
+	};
+
+	struct time_index_entry {
+		std::uint64_t offset;
+		std::int64_t ms;
+	};
+
+	namespace details {
+		inline constexpr char time_index_magic[8] = { 'D', 'A', 'W', 'T',
+		                                              'S', 'I', 'D', '1' };
+		inline constexpr std::size_t time_index_block_size = 64;
+		inline constexpr std::size_t time_index_table_entry_size = 24;
+		inline constexpr std::size_t time_index_footer_size = 64;
+
+		inline void put_u64( std::vector<char> &out, std::uint64_t value ) {
+			for( std::size_t n = 0; n < 8; ++n ) {
+				out.push_back( static_cast<char>( value & 0xFFU ) );
+				value >>= 8U;
+			}
+		}
+
+		constexpr std::uint64_t get_u64( char const *ptr ) noexcept {
+			std::uint64_t result = 0;
+			for( std::size_t n = 8; n > 0; --n ) {
+				result = ( result << 8U ) |
+				         static_cast<std::uint64_t>(
+				           static_cast<unsigned char>( ptr[n - 1U] ) );
+			}
+			return result;
+		}
+
+		inline void put_varint( std::vector<char> &out, std::uint64_t value ) {
+			while( value >= 0x80U ) {
+				out.push_back( static_cast<char>( ( value & 0x7FU ) | 0x80U ) );
+				value >>= 7U;
+			}
+			out.push_back( static_cast<char>( value ) );
+		}
+
+		constexpr std::uint64_t get_varint( char const *&ptr,
+		                                    char const *last ) {
+			std::uint64_t result = 0;
+			for( unsigned shift = 0; shift < 64U; shift += 7U ) {
+				daw::exception::precondition_check<invalid_time_index>( ptr < last );
+				auto const byte = static_cast<unsigned char>( *ptr++ );
+				result |= static_cast<std::uint64_t>( byte & 0x7FU ) << shift;
+				if( ( byte & 0x80U ) == 0 ) {
+					return result;
+				}
+			}
+			daw::exception::daw_throw<invalid_time_index>( );
+		}
+
+		constexpr std::uint64_t zigzag_encode( std::int64_t const value ) noexcept {
+			return ( static_cast<std::uint64_t>( value ) << 1U ) ^
+			       static_cast<std::uint64_t>( value >> 63 );
+		}
+
+		constexpr std::int64_t zigzag_decode( std::uint64_t const value ) noexcept {
+			return static_cast<std::int64_t>( value >> 1U ) ^
+			       -static_cast<std::int64_t>( value & 1U );
+		}
+	} // namespace details
+
+	/// A read only view of a serialized index, typically memory mapped
+	class time_index_view {
+		daw::string_view m_data{ };
+		char const *m_table = nullptr;
+		std::uint64_t m_block_count = 0;
+		std::uint64_t m_entry_count = 0;
+		std::uint64_t m_indexed_size = 0;
+
+		[[nodiscard]] time_index_entry block_front( std::size_t const block ) const {
+			auto const *ptr =
+			  m_table + block * details::time_index_table_entry_size;
+			return time_index_entry{
+			  details::get_u64( ptr ),
+			  static_cast<std::int64_t>( details::get_u64( ptr + 8 ) ) };
+		}
+
+		[[nodiscard]] std::size_t block_entry_count( std::size_t const block ) const {
+			if( block + 1U < m_block_count ) {
+				return details::time_index_block_size;
+			}
+			return static_cast<std::size_t>(
+			  m_entry_count - block * details::time_index_block_size );
+		}
+
+		// Calls f( entry ) for every entry of the block until it returns false
+		template<typename Function>
+		void for_each_in_block( std::size_t const block, Function &&f ) const {
+			auto entry = block_front( block );
+			if( not f( entry ) ) {
+				return;
+			}
+			auto const *ptr =
+			  m_data.data( ) +
+			  details::get_u64( m_table + block * details::time_index_table_entry_size +
+			                    16 );
+			auto const *const last = m_table;
+			auto const count = block_entry_count( block );
+			for( std::size_t n = 1; n < count; ++n ) {
+				entry.offset += details::get_varint( ptr, last );
+				entry.ms += details::zigzag_decode( details::get_varint( ptr, last ) );
+				if( not f( entry ) ) {
+					return;
+				}
+			}
+		}
+
+		// Index of the first block whose first entry has ms >= key
+		[[nodiscard]] std::size_t first_block_not_less( std::int64_t const key ) const {
+			std::size_t lo = 0;
+			auto hi = static_cast<std::size_t>( m_block_count );
+			while( lo < hi ) {
+				auto const mid = lo + ( hi - lo ) / 2U;
+				if( block_front( mid ).ms < key ) {
+					lo = mid + 1U;
+				} else {
+					hi = mid;
+				}
+			}
+			return lo;
+		}
+
+	public:
+		time_index_view( ) = default;
+
+		explicit time_index_view( daw::string_view data )
+		  : m_data( data ) {
+			daw::exception::precondition_check<invalid_time_index>(
+			  data.size( ) >= details::time_index_footer_size );
+			auto const *footer =
+			  data.data( ) + data.size( ) - details::time_index_footer_size;
+			daw::exception::precondition_check<invalid_time_index>(
+			  std::memcmp( footer + 56, details::time_index_magic, 8 ) == 0 );
+			auto const table_pos = details::get_u64( footer + 16 );
+			m_block_count = details::get_u64( footer + 24 );
+			m_entry_count = details::get_u64( footer + 32 );
+			m_indexed_size = details::get_u64( footer + 40 );
+			daw::exception::precondition_check<invalid_time_index>(
+			  table_pos + m_block_count * details::time_index_table_entry_size ==
+			    data.size( ) - details::time_index_footer_size and
+			  m_entry_count <= m_block_count * details::time_index_block_size );
+			m_table = data.data( ) + table_pos;
+		}
+
+		[[nodiscard]] std::uint64_t size( ) const noexcept {
+			return m_entry_count;
+		}
+
+		[[nodiscard]] std::uint64_t indexed_size( ) const noexcept {
+			return m_indexed_size;
+		}
+
+		/// A range of the log, starting and ending on line boundaries, that
+		/// contains every line with a timestamp in [begin, end).  log_size is the
+		/// current size of the log, which may have grown since it was indexed
+		template<typename Duration>
+		[[nodiscard]] byte_range narrow( date::sys_time<Duration> const begin,
+		                                 date::sys_time<Duration> const end,
+		                                 std::uint64_t const log_size ) const {
+			// Entries are floored to ms.  An entry below floor( begin ) is before
+			// begin and one at or above ceil( end ) is at or after end.  An empty
+			// range still needs a span that holds the position of begin
+			auto const lo_key = static_cast<std::int64_t>(
+			  std::chrono::floor<std::chrono::milliseconds>( begin )
+			    .time_since_epoch( )
+			    .count( ) );
+			auto const hi_key = static_cast<std::int64_t>(
+			  std::chrono::ceil<std::chrono::milliseconds>( end < begin ? begin : end )
+			    .time_since_epoch( )
+			    .count( ) );
+			std::uint64_t first = 0;
+			auto block = first_block_not_less( lo_key );
+			if( block > 0 ) {
+				for_each_in_block( block - 1U, [&]( time_index_entry const &e ) {
+					if( e.ms < lo_key ) {
+						first = e.offset;
+						return true;
+					}
+					return false;
+				} );
+			}
+			auto last = log_size;
+			block = first_block_not_less( hi_key );
+			// The first entry >= hi_key is either in the preceding block or is the
+			// front of this one
+			if( block > 0 ) {
+				bool found = false;
+				for_each_in_block( block - 1U, [&]( time_index_entry const &e ) {
+					if( e.ms >= hi_key ) {
+						last = e.offset;
+						found = true;
+						return false;
+					}
+					return true;
+				} );
+				if( not found and block < m_block_count ) {
+					last = block_front( block ).offset;
+				}
+			} else if( m_block_count > 0 ) {
+				last = block_front( 0 ).offset;
+			}
+			if( last < first ) {
+				last = first;
+			}
+			return byte_range{ static_cast<std::size_t>( first ),
+			                   static_cast<std::size_t>( last ) };
+		}
+	};
+
+	/// Builds, extends and serializes a sparse time index
+	class time_index {
+		time_index_options m_options{ };
+		std::vector<time_index_entry> m_entries{ };
+		std::uint64_t m_indexed_size = 0;
+		std::uint64_t m_lines_since_entry = 0;
+
+	public:
+		time_index( ) = default;
+
+		explicit time_index( time_index_options options )
+		  : m_options( options ) {
+			daw::exception::precondition_check<invalid_time_index>(
+			  options.line_stride > 0 and options.byte_stride > 0 );
+		}
+
+		/// Decode a serialized index so that it can be extended
+		explicit time_index( daw::string_view const data ) {
+			auto const view = time_index_view( data );
+			auto const *footer =
+			  data.data( ) + data.size( ) - details::time_index_footer_size;
+			m_options.line_stride = details::get_u64( footer );
+			m_options.byte_stride = details::get_u64( footer + 8 );
+			m_indexed_size = view.indexed_size( );
+			m_lines_since_entry = details::get_u64( footer + 48 );
+			auto const *table = data.data( ) + details::get_u64( footer + 16 );
+			auto const block_count = details::get_u64( footer + 24 );
+			m_entries.reserve( static_cast<std::size_t>( view.size( ) ) );
+			for( std::uint64_t block = 0; block < block_count; ++block ) {
+				auto const *row = table + block * details::time_index_table_entry_size;
+				auto entry = time_index_entry{
+				  details::get_u64( row ),
+				  static_cast<std::int64_t>( details::get_u64( row + 8 ) ) };
+				m_entries.push_back( entry );
+				auto const *ptr = data.data( ) + details::get_u64( row + 16 );
+				auto const remaining = view.size( ) - m_entries.size( );
+				auto const count = remaining < details::time_index_block_size - 1U
+				                     ? remaining
+				                     : details::time_index_block_size - 1U;
+				for( std::uint64_t n = 0; n < count; ++n ) {
+					entry.offset += details::get_varint( ptr, table );
+					entry.ms += details::zigzag_decode( details::get_varint( ptr, table ) );
+					m_entries.push_back( entry );
+				}
+			}
+		}
+
+		[[nodiscard]] std::vector<time_index_entry> const &entries( ) const noexcept {
+			return m_entries;
+		}
+
+		[[nodiscard]] std::uint64_t indexed_size( ) const noexcept {
+			return m_indexed_size;
+		}
+
+		/// Index the complete lines of log past indexed_size( ).  Only the lines
+		/// that become entries are parsed.  A log that is smaller than what was
+		/// indexed is assumed to have been replaced and is indexed from scratch
+		void extend( daw::string_view const log ) {
+			if( log.size( ) < m_indexed_size ) {
+				m_entries.clear( );
+				m_indexed_size = 0;
+				m_lines_since_entry = 0;
+			}
+			auto pos = static_cast<std::size_t>( m_indexed_size );
+			auto last_offset =
+			  m_entries.empty( ) ? std::uint64_t{ 0 } : m_entries.back( ).offset;
+			while( pos < log.size( ) ) {
+				auto const *nl = static_cast<char const *>(
+				  std::memchr( log.data( ) + pos, '\n', log.size( ) - pos ) );
+				if( nl == nullptr ) {
+					// Leave the partial last line for the next extension
+					break;
+				}
+				auto const next = static_cast<std::size_t>( nl - log.data( ) ) + 1U;
+				if( m_entries.empty( ) or
+				    m_lines_since_entry >= m_options.line_stride or
+				    pos - last_offset >= m_options.byte_stride ) {
+					details::timestamp_fields fields{ };
+					if( details::try_parse_leading_timestamp(
+					      log.substr( pos, next - pos - 1U ), fields ) ) {
+						m_entries.push_back( time_index_entry{
+						  pos, details::to_epoch<std::chrono::milliseconds>( fields ) } );
+						last_offset = pos;
+						m_lines_since_entry = 0;
+					}
+				}
+				++m_lines_since_entry;
+				pos = next;
+			}
+			m_indexed_size = pos;
+		}
+
+		[[nodiscard]] std::vector<char> serialize( ) const {
+			std::vector<char> result{ };
+			std::vector<std::uint64_t> block_pos{ };
+			for( std::size_t n = 0; n < m_entries.size( ); ++n ) {
+				if( n % details::time_index_block_size == 0 ) {
+					block_pos.push_back( result.size( ) );
+					continue;
+				}
+				details::put_varint( result,
+				                     m_entries[n].offset - m_entries[n - 1U].offset );
+				details::put_varint(
+				  result,
+				  details::zigzag_encode( m_entries[n].ms - m_entries[n - 1U].ms ) );
+			}
+			auto const table_pos = static_cast<std::uint64_t>( result.size( ) );
+			for( std::size_t block = 0; block < block_pos.size( ); ++block ) {
+				auto const &front = m_entries[block * details::time_index_block_size];
+				details::put_u64( result, front.offset );
+				details::put_u64( result, static_cast<std::uint64_t>( front.ms ) );
+				details::put_u64( result, block_pos[block] );
+			}
+			details::put_u64( result, m_options.line_stride );
+			details::put_u64( result, m_options.byte_stride );
+			details::put_u64( result, table_pos );
+			details::put_u64( result, block_pos.size( ) );
+			details::put_u64( result, m_entries.size( ) );
+			details::put_u64( result, m_indexed_size );
+			details::put_u64( result, m_lines_since_entry );
+			result.insert( result.end( ), std::begin( details::time_index_magic ),
+			               std::end( details::time_index_magic ) );
+			return result;
+		}
+
+		void write( std::string const &path ) const {
+			auto const data = serialize( );
+			std::ofstream out( path, std::ios::binary | std::ios::trunc );
+			out.write( data.data( ), static_cast<std::streamsize>( data.size( ) ) );
+			daw::exception::precondition_check<invalid_time_index>( out.good( ) );
+		}
+	};
+
+	/// find_time_range that first narrows the log with a sidecar index so that
+	/// only the pages of a small span of the log are touched
+	template<typename Mapping, typename Duration>
+	byte_range find_time_range( time_index_view const &index,
+	                            Mapping const &mapping,
+	                            date::sys_time<Duration> const begin,
+	                            date::sys_time<Duration> const end ) {
+		auto const log =
+		  daw::string_view( std::data( mapping ), std::size( mapping ) );
+		auto const span = index.narrow( begin, end, log.size( ) );
+		auto const result = find_time_range(
+		  log.substr( span.first, span.size( ) ), begin, end );
+		return byte_range{ span.first + result.first, span.first + result.last };
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,265 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <daw/daw_string_view.h>
+
+#include "daw_date_parsing.h"
+#include "daw_log_search.h"
+
+namespace daw::date_parsing {
+	namespace details {
+		// UTC sort key of a record.  Seconds and nanoseconds are kept apart so
+		// that the full precision of the text is compared for any year
+		struct merge_key {
+			std::int64_t secs;
+			std::uint32_t ns;
+
+			constexpr bool operator<( merge_key const &rhs ) const noexcept {
+				return secs < rhs.secs or ( secs == rhs.secs and ns < rhs.ns );
+			}
+		};
+
+		inline constexpr merge_key merge_key_min =
+		  merge_key{ std::numeric_limits<std::int64_t>::min( ), 0 };
+
+		// One sorted input.  The current record is a line with a leading
+		// timestamp plus any following lines without one.  Consecutive lines of
+		// a log nearly always share their date, so the days of the last date
+		// prefix seen are cached and only the time and offset are parsed
+		class merge_cursor {
+			daw::string_view m_remaining{ };
+			daw::string_view m_record{ };
+			merge_key m_key{ };
+			// The pending line was split from m_remaining and is already parsed
+			daw::string_view m_pending{ };
+			merge_key m_pending_key{ };
+			bool m_has_pending = false;
+			char m_date_prefix[10]{ };
+			std::size_t m_date_prefix_size = 0;
+			std::int64_t m_date_days = 0;
+
+			static daw::string_view split_line( daw::string_view &buff ) noexcept {
+				auto const *nl = static_cast<char const *>(
+				  std::memchr( buff.data( ), '\n', buff.size( ) ) );
+				auto const size = nl == nullptr
+				                    ? buff.size( )
+				                    : static_cast<std::size_t>( nl - buff.data( ) ) + 1U;
+				auto const result = buff.substr( 0, size );
+				buff.remove_prefix( size );
+				return result;
+			}
+
+			bool try_key( daw::string_view const line, merge_key &key ) noexcept {
+				auto ts = leading_timestamp( line );
+				timestamp_fields fields{ };
+				std::int64_t days = 0;
+				if( m_date_prefix_size > 0 and ts.size( ) > m_date_prefix_size and
+				    std::memcmp( ts.data( ), m_date_prefix, m_date_prefix_size ) == 0 ) {
+					ts.remove_prefix( m_date_prefix_size );
+					days = m_date_days;
+				} else {
+					auto const first = ts;
+					if( not try_parse_iso8601_date( ts, fields ) ) {
+						return false;
+					}
+					days = daw::details::days_from_civil( fields.y, fields.mo, fields.d );
+					m_date_prefix_size = first.size( ) - ts.size( );
+					std::memcpy( m_date_prefix, first.data( ), m_date_prefix_size );
+					m_date_days = days;
+				}
+				if( not try_parse_iso8601_time( ts, fields ) ) {
+					return false;
+				}
+				key.secs = days * 86400 + static_cast<std::int64_t>( fields.h ) * 3600 +
+				           static_cast<std::int64_t>( fields.mi ) * 60 +
+				           static_cast<std::int64_t>( fields.s ) -
+				           static_cast<std::int64_t>( fields.offset ) * 60;
+				key.ns = fields.ns;
+				return true;
+			}
+
+		public:
+			merge_cursor( ) = default;
+
+			explicit merge_cursor( daw::string_view input ) noexcept
+			  : m_remaining( input ) {
+				advance( );
+			}
+
+			[[nodiscard]] bool empty( ) const noexcept {
+				return m_record.empty( );
+			}
+
+			[[nodiscard]] daw::string_view record( ) const noexcept {
+				return m_record;
+			}
+
+			[[nodiscard]] merge_key key( ) const noexcept {
+				return m_key;
+			}
+
+			// Move to the next record, parsing each line exactly once
+			void advance( ) noexcept {
+				if( m_has_pending ) {
+					m_record = m_pending;
+					m_key = m_pending_key;
+					m_has_pending = false;
+				} else if( m_remaining.empty( ) ) {
+					m_record = daw::string_view( );
+					return;
+				} else {
+					m_record = split_line( m_remaining );
+					// Lines before the first timestamp sort before everything
+					if( not try_key( m_record, m_key ) ) {
+						m_key = merge_key_min;
+					}
+				}
+				// Extend the record over continuation lines
+				while( not m_remaining.empty( ) ) {
+					auto const line = split_line( m_remaining );
+					if( try_key( line, m_pending_key ) ) {
+						m_pending = line;
+						m_has_pending = true;
+						return;
+					}
+					m_record = daw::string_view( m_record.data( ),
+					                             m_record.size( ) + line.size( ) );
+				}
+			}
+		};
+
+		// A loser tree over the cursors.  Node 0 holds the overall winner, nodes
+		// [1, k) hold the loser of the match played there and the cursor s is
+		// the leaf k + s.  Ties go to the lower input index so the merge is
+		// stable
+		class loser_tree {
+			std::vector<merge_cursor> &m_cursors;
+			std::vector<std::size_t> m_nodes;
+
+			[[nodiscard]] bool beats( std::size_t const lhs,
+			                          std::size_t const rhs ) const noexcept {
+				auto const &l = m_cursors[lhs];
+				auto const &r = m_cursors[rhs];
+				if( l.empty( ) or r.empty( ) ) {
+					return r.empty( ) and ( not l.empty( ) or lhs < rhs );
+				}
+				if( l.key( ) < r.key( ) ) {
+					return true;
+				}
+				if( r.key( ) < l.key( ) ) {
+					return false;
+				}
+				return lhs < rhs;
+			}
+
+		public:
+			explicit loser_tree( std::vector<merge_cursor> &cursors )
+			  : m_cursors( cursors )
+			  , m_nodes( cursors.size( ) ) {
+				auto const k = cursors.size( );
+				if( k == 0 ) {
+					return;
+				}
+				// winners[n] is the winner of the subtree rooted at node n
+				std::vector<std::size_t> winners( 2U * k );
+				for( std::size_t s = 0; s < k; ++s ) {
+					winners[k + s] = s;
+				}
+				for( auto n = k - 1U; n > 0; --n ) {
+					auto const a = winners[2U * n];
+					auto const b = winners[2U * n + 1U];
+					auto const a_wins = beats( a, b );
+					winners[n] = a_wins ? a : b;
+					m_nodes[n] = a_wins ? b : a;
+				}
+				m_nodes[0] = k == 1 ? 0 : winners[1];
+			}
+
+			[[nodiscard]] std::size_t winner( ) const noexcept {
+				return m_nodes[0];
+			}
+
+			// Replay the path of the winner after its cursor has advanced
+			void replay( ) noexcept {
+				auto const k = m_cursors.size( );
+				auto current = m_nodes[0];
+				for( auto n = ( k + current ) / 2U; n > 0; n /= 2U ) {
+					if( beats( m_nodes[n], current ) ) {
+						std::swap( m_nodes[n], current );
+					}
+				}
+				m_nodes[0] = current;
+			}
+		};
+	} // namespace details
+
+	/// Merge logs that are each sorted by a leading ISO 8601 timestamp into one
+	/// stream ordered by UTC time.  sink is called with each record, a line
+	/// plus any continuation lines without a timestamp, as a view into the
+	/// input so nothing is copied.  The last record of an input may not end in
+	/// a newline.  Records with equal times keep the order of the inputs
+	template<typename Inputs, typename Sink>
+	void merge_sorted_logs( Inputs const &inputs, Sink &&sink ) {
+		std::vector<details::merge_cursor> cursors{ };
+		for( auto const &input : inputs ) {
+			cursors.emplace_back(
+			  daw::string_view( std::data( input ), std::size( input ) ) );
+		}
+		if( cursors.empty( ) ) {
+			return;
+		}
+		auto tree = details::loser_tree( cursors );
+		while( true ) {
+			auto &cursor = cursors[tree.winner( )];
+			if( cursor.empty( ) ) {
+				return;
+			}
+			sink( cursor.record( ) );
+			cursor.advance( );
+			tree.replay( );
+		}
+	}
+
+	/// A merge sink that writes records to a FILE, ending each with a newline
+	struct file_sink {
+		std::FILE *file;
+
+		void operator( )( daw::string_view const record ) const {
+			std::fwrite( record.data( ), 1, record.size( ), file );
+			if( record.empty( ) or record.back( ) != '\n' ) {
+				std::fputc( '\n', file );
+			}
+		}
+	};
+} // namespace daw::date_parsing
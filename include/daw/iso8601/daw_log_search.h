@@ -0,0 +1,166 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include <daw/daw_string_view.h>
+
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	/// A [first, last) range of byte offsets into a buffer
+	struct byte_range {
+		std::size_t first = 0;
+		std::size_t last = 0;
+
+		[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+			return last - first;
+		}
+
+		[[nodiscard]] constexpr bool empty( ) const noexcept {
+			return first == last;
+		}
+	};
+
+	namespace details {
+		constexpr bool is_token_end( char const c ) noexcept {
+			return c == ' ' or c == '\t' or c == '\r' or c == '\n';
+		}
+
+		/// The timestamp at the start of a log line.  It ends at the first
+		/// whitespace, except that a space between the date and time, as in
+		/// "2017-01-02 13:14:15Z", is part of the timestamp
+		constexpr daw::string_view
+		leading_timestamp( daw::string_view const line ) noexcept {
+			std::size_t pos = 0;
+			if( line.size( ) > 11 and line[10] == ' ' and
+			    daw::details::is_digit( line[11] ) ) {
+				pos = 11;
+			}
+			while( pos < line.size( ) and not is_token_end( line[pos] ) ) {
+				++pos;
+			}
+			return line.substr( 0, pos );
+		}
+
+		constexpr bool
+		try_parse_leading_timestamp( daw::string_view const line,
+		                             timestamp_fields &result ) noexcept {
+			return try_parse_iso8601_timestamp( leading_timestamp( line ), result );
+		}
+
+		/// Offset of the first line starting at or after pos
+		inline std::size_t line_start_at_or_after( daw::string_view const buff,
+		                                           std::size_t const pos ) noexcept {
+			if( pos == 0 or pos >= buff.size( ) or buff[pos - 1] == '\n' ) {
+				return pos < buff.size( ) ? pos : buff.size( );
+			}
+			auto const *nl = static_cast<char const *>(
+			  std::memchr( buff.data( ) + pos, '\n', buff.size( ) - pos ) );
+			if( nl == nullptr ) {
+				return buff.size( );
+			}
+			return static_cast<std::size_t>( nl - buff.data( ) ) + 1U;
+		}
+
+		/// Offset of the line following the one starting at line_start
+		inline std::size_t next_line_start( daw::string_view const buff,
+		                                    std::size_t const line_start ) noexcept {
+			return line_start_at_or_after( buff, line_start + 1U );
+		}
+
+		inline daw::string_view line_at( daw::string_view const buff,
+		                                 std::size_t const line_start ) noexcept {
+			auto const *first = buff.data( ) + line_start;
+			auto const remaining = buff.size( ) - line_start;
+			auto const *nl =
+			  static_cast<char const *>( std::memchr( first, '\n', remaining ) );
+			return daw::string_view(
+			  first, nl == nullptr ? remaining
+			                       : static_cast<std::size_t>( nl - first ) );
+		}
+
+		/// Offset of the first line whose leading timestamp is >= key.  Lines
+		/// without a timestamp, such as continuations of a multi-line message,
+		/// are never a boundary.  Only the lines probed by the binary search are
+		/// parsed
+		template<typename Duration>
+		std::size_t lower_bound_line( daw::string_view const buff,
+		                              std::int64_t const key ) noexcept {
+			auto best = buff.size( );
+			std::size_t lo = 0;
+			auto bound = buff.size( );
+			// best is the answer unless a smaller one is in [lo, bound)
+			while( lo < bound ) {
+				auto const mid = lo + ( bound - lo ) / 2U;
+				auto probe = line_start_at_or_after( buff, mid );
+				timestamp_fields fields{ };
+				bool found = false;
+				while( probe < bound ) {
+					if( try_parse_leading_timestamp( line_at( buff, probe ), fields ) ) {
+						found = true;
+						break;
+					}
+					probe = next_line_start( buff, probe );
+				}
+				if( found and to_epoch<Duration>( fields ) < key ) {
+					lo = next_line_start( buff, probe );
+				} else {
+					if( found ) {
+						best = probe;
+					}
+					bound = mid;
+				}
+			}
+			return best;
+		}
+	} // namespace details
+
+	/// Find the lines of a log, sorted by a leading ISO 8601 timestamp, whose
+	/// timestamp is in [begin, end).  mapping is any contiguous character
+	/// buffer such as daw::filesystem::memory_mapped_file_t.  This is a binary
+	/// search over byte offsets that parses O(log n) lines
+	/// @return the byte range from the start of the first matching line to the
+	/// start of the first line at or after end
+	template<typename Mapping, typename Duration>
+	byte_range find_time_range( Mapping const &mapping,
+	                            date::sys_time<Duration> const begin,
+	                            date::sys_time<Duration> const end ) {
+		auto const buff = daw::string_view( std::data( mapping ), std::size( mapping ) );
+		auto const first = details::lower_bound_line<Duration>(
+		  buff, static_cast<std::int64_t>( begin.time_since_epoch( ).count( ) ) );
+		if( not( begin < end ) ) {
+			return byte_range{ first, first };
+		}
+		auto const last = details::lower_bound_line<Duration>(
+		  buff.substr( first ),
+		  static_cast<std::int64_t>( end.time_since_epoch( ).count( ) ) );
+		return byte_range{ first, first + last };
+	}
+} // namespace daw::date_parsing
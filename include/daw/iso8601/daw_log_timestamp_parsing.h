@@ -0,0 +1,200 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <date/date.h>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+
+#include "daw_common.h"
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	namespace details {
+		// The three bytes of a month or weekday abbreviation, lower cased
+		constexpr std::uint32_t pack_abbreviation( char const *name ) noexcept {
+			return ( static_cast<std::uint32_t>( static_cast<unsigned char>( name[0] ) ) |
+			         static_cast<std::uint32_t>( static_cast<unsigned char>( name[1] ) )
+			           << 8U |
+			         static_cast<std::uint32_t>( static_cast<unsigned char>( name[2] ) )
+			           << 16U ) |
+			       0x20'2020U;
+		}
+
+		constexpr std::uint32_t month_name_hash( std::uint32_t const packed ) noexcept {
+			return ( ( packed * 61U ) >> 15U ) & 0xFU;
+		}
+
+		struct month_name_entry {
+			std::uint32_t packed;
+			std::uint8_t month;
+		};
+
+		// Indexed by month_name_hash, which is a perfect hash of the 12 lower
+		// case English month abbreviations.  The unused slots never match
+		inline constexpr month_name_entry month_name_table[16] = {
+		  { pack_abbreviation( "sep" ), 9 },
+		  { pack_abbreviation( "nov" ), 11 },
+		  { pack_abbreviation( "mar" ), 3 },
+		  { pack_abbreviation( "jun" ), 6 },
+		  { pack_abbreviation( "feb" ), 2 },
+		  { 0, 0 },
+		  { 0, 0 },
+		  { pack_abbreviation( "oct" ), 10 },
+		  { pack_abbreviation( "may" ), 5 },
+		  { pack_abbreviation( "apr" ), 4 },
+		  { pack_abbreviation( "jan" ), 1 },
+		  { 0, 0 },
+		  { 0, 0 },
+		  { pack_abbreviation( "aug" ), 8 },
+		  { pack_abbreviation( "dec" ), 12 },
+		  { pack_abbreviation( "jul" ), 7 } };
+
+		/// Month number, 1-12, of a case insensitive English month abbreviation
+		/// or 0 when name is not one
+		constexpr std::uint8_t parse_month_name( char const *name ) noexcept {
+			auto const packed = pack_abbreviation( name );
+			auto const &entry = month_name_table[month_name_hash( packed )];
+			return entry.packed == packed ? entry.month : 0;
+		}
+
+		constexpr bool is_digits( char const *str, std::size_t const count ) noexcept {
+			for( std::size_t n = 0; n < count; ++n ) {
+				if( !daw::details::is_digit( str[n] ) ) {
+					return false;
+				}
+			}
+			return true;
+		}
+	} // namespace details
+
+	/// Parse a BSD syslog (RFC 3164) timestamp, Mmm dd hh:mm:ss, where the day
+	/// may be space padded.  The format has neither a year nor a zone, so the
+	/// year is supplied and the time is taken as UTC
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::milliseconds>
+	parse_syslog_timestamp( daw::string_view const timestamp_str,
+	                        std::int32_t const year ) {
+		daw::exception::precondition_check<invalid_syslog_timestamp>(
+		  timestamp_str.size( ) == 15 and timestamp_str[3] == ' ' and
+		  timestamp_str[6] == ' ' and timestamp_str[9] == ':' and
+		  timestamp_str[12] == ':' and
+		  ( timestamp_str[4] == ' ' or daw::details::is_digit( timestamp_str[4] ) ) and
+		  details::is_digits( timestamp_str.data( ) + 5, 1 ) and
+		  details::is_digits( timestamp_str.data( ) + 7, 2 ) and
+		  details::is_digits( timestamp_str.data( ) + 10, 2 ) and
+		  details::is_digits( timestamp_str.data( ) + 13, 2 ) );
+		auto const mo = details::parse_month_name( timestamp_str.data( ) );
+		auto const dy = static_cast<std::uint32_t>(
+		  ( timestamp_str[4] == ' '
+		      ? 0
+		      : daw::details::to_integer<std::uint32_t>( timestamp_str[4] ) * 10U ) +
+		  daw::details::to_integer<std::uint32_t>( timestamp_str[5] ) );
+		daw::exception::precondition_check<invalid_syslog_timestamp>(
+		  mo != 0 and dy >= 1 and dy <= details::last_day_of_month( year, mo ) );
+		auto const hr =
+		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 7 );
+		auto const mi =
+		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 10 );
+		auto const sc =
+		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 13 );
+
+		std::chrono::time_point<std::chrono::system_clock,
+		                        std::chrono::milliseconds>
+		  result{ date::sys_days{ date::year{ year } / date::month( mo ) /
+		                          date::day( dy ) } +
+		          std::chrono::hours{ hr } + std::chrono::minutes{ mi } +
+		          std::chrono::seconds{ sc } };
+
+		return result;
+	}
+
+	template<typename CharT, size_t N>
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::milliseconds>
+	parse_syslog_timestamp( CharT const ( &timestamp_str )[N],
+	                        std::int32_t const year ) {
+		return parse_syslog_timestamp(
+		  daw::details::to_string_view( timestamp_str ), year );
+	}
+
+	/// Parse an Apache/Nginx Common Log Format timestamp,
+	/// dd/Mmm/yyyy:hh:mm:ss +hhmm, with or without the surrounding brackets
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::milliseconds>
+	parse_clf_timestamp( daw::string_view timestamp_str ) {
+		if( !timestamp_str.empty( ) and timestamp_str.front( ) == '[' ) {
+			daw::exception::precondition_check<invalid_clf_timestamp>(
+			  timestamp_str.back( ) == ']' );
+			timestamp_str.remove_prefix( 1 );
+			timestamp_str.remove_suffix( 1 );
+		}
+		daw::exception::precondition_check<invalid_clf_timestamp>(
+		  timestamp_str.size( ) >= 26 and timestamp_str[2] == '/' and
+		  timestamp_str[6] == '/' and timestamp_str[11] == ':' and
+		  timestamp_str[14] == ':' and timestamp_str[17] == ':' and
+		  timestamp_str[20] == ' ' and
+		  details::is_digits( timestamp_str.data( ), 2 ) and
+		  details::is_digits( timestamp_str.data( ) + 7, 4 ) and
+		  details::is_digits( timestamp_str.data( ) + 12, 2 ) and
+		  details::is_digits( timestamp_str.data( ) + 15, 2 ) and
+		  details::is_digits( timestamp_str.data( ) + 18, 2 ) );
+		auto const dy =
+		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) );
+		auto const mo = details::parse_month_name( timestamp_str.data( ) + 3 );
+		auto const yr =
+		  daw::details::parse_unsigned<uint16_t, 4>( timestamp_str.data( ) + 7 );
+		daw::exception::precondition_check<invalid_clf_timestamp>(
+		  mo != 0 and dy >= 1 and dy <= details::last_day_of_month( yr, mo ) );
+		auto const hr =
+		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 12 );
+		auto const mi =
+		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 15 );
+		auto const sc =
+		  daw::details::parse_unsigned<uint8_t, 2>( timestamp_str.data( ) + 18 );
+		timestamp_str.remove_prefix( 21 );
+		auto const ofst = details::parse_offset( timestamp_str );
+
+		std::chrono::time_point<std::chrono::system_clock,
+		                        std::chrono::milliseconds>
+		  result{ date::sys_days{ date::year{ yr } / date::month( mo ) /
+		                          date::day( dy ) } +
+		          std::chrono::hours{ hr } + std::chrono::minutes{ mi } +
+		          std::chrono::seconds{ sc } };
+
+		result = result - std::chrono::minutes{ ofst };
+		return result;
+	}
+
+	template<typename CharT, size_t N>
+	constexpr std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::milliseconds>
+	parse_clf_timestamp( CharT const ( &timestamp_str )[N] ) {
+		return parse_clf_timestamp(
+		  daw::details::to_string_view( timestamp_str ) );
+	}
+} // namespace daw::date_parsing
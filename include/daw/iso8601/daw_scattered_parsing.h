@@ -0,0 +1,94 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "daw_common.h"
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	/// Parse count ISO 8601 timestamps scattered across memory, such as the
+	/// elements of a std::vector<std::string> or an array of string views, to
+	/// the dense array out as a count of Unit since the epoch.  The text of the
+	/// item PrefetchDistance ahead is prefetched, and items are parsed
+	/// GroupSize at a time with the conversions after all of the parses, so that
+	/// the cache misses and digit conversions of neighbouring items overlap.
+	/// Invalid timestamps are written as 0
+	/// @return the number of invalid timestamps
+	template<typename Unit = std::chrono::milliseconds,
+	         std::size_t PrefetchDistance = 8, std::size_t GroupSize = 4,
+	         typename String>
+	std::size_t parse_iso8601_timestamps_scattered( String const *items,
+	                                                std::size_t const count,
+	                                                std::int64_t *out ) noexcept {
+		static_assert( GroupSize > 0, "Groups must hold at least one item" );
+		auto const prefetch = [&]( std::size_t const n ) {
+			if( PrefetchDistance > 0 and n + PrefetchDistance < count ) {
+				daw::details::prefetch( std::data( items[n + PrefetchDistance] ) );
+			}
+		};
+		for( std::size_t n = 0; n < PrefetchDistance and n < count; ++n ) {
+			daw::details::prefetch( std::data( items[n] ) );
+		}
+		std::size_t invalid_count = 0;
+		std::size_t n = 0;
+		for( ; n + GroupSize <= count; n += GroupSize ) {
+			details::timestamp_fields fields[GroupSize]{ };
+			bool is_valid[GroupSize]{ };
+			for( std::size_t g = 0; g < GroupSize; ++g ) {
+				prefetch( n + g );
+				is_valid[g] = details::try_parse_iso8601_timestamp(
+				  daw::details::to_string_view( items[n + g] ), fields[g] );
+			}
+			for( std::size_t g = 0; g < GroupSize; ++g ) {
+				out[n + g] = is_valid[g] ? details::to_epoch<Unit>( fields[g] ) : 0;
+				invalid_count += static_cast<std::size_t>( not is_valid[g] );
+			}
+		}
+		for( ; n < count; ++n ) {
+			details::timestamp_fields fields{ };
+			bool const is_valid = details::try_parse_iso8601_timestamp(
+			  daw::details::to_string_view( items[n] ), fields );
+			out[n] = is_valid ? details::to_epoch<Unit>( fields ) : 0;
+			invalid_count += static_cast<std::size_t>( not is_valid );
+		}
+		return invalid_count;
+	}
+
+	/// As above for a contiguous range of items, e.g. a
+	/// std::vector<std::string>, writing std::size( items ) results
+	template<typename Unit = std::chrono::milliseconds,
+	         std::size_t PrefetchDistance = 8, std::size_t GroupSize = 4,
+	         typename Range>
+	std::size_t parse_iso8601_timestamps_scattered( Range const &items,
+	                                                std::int64_t *out ) noexcept {
+		return parse_iso8601_timestamps_scattered<Unit, PrefetchDistance,
+		                                          GroupSize>(
+		  std::data( items ), std::size( items ), out );
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,145 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "daw_common.h"
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	/// The width of a YYYY-MM-DDTHH:MM:SS.sssZ field
+	inline constexpr std::size_t javascript_timestamp_size = 24;
+
+	namespace details {
+		// YYYY-MM-DDTHH:MM:SS.sssZ as three 8 byte chunks.  The masks select the
+		// digit lanes, with the first character in the low byte
+		inline constexpr std::uint64_t javascript_digit_lanes[3] = {
+		  0x00FF'FF00'FFFF'FFFFULL, 0xFFFF'00FF'FF00'FFFFULL,
+		  0x00FF'FFFF'00FF'FF00ULL };
+		// The separators, - - T : : . Z, after folding the case of T and Z
+		inline constexpr std::uint64_t javascript_separators[3] = {
+		  0x2D00'002D'0000'0000ULL, 0x0000'3A00'0074'0000ULL,
+		  0x7A00'0000'2E00'003AULL };
+		inline constexpr std::uint64_t javascript_case_fold[3] = {
+		  0, 0x0000'0000'0020'0000ULL, 0x2000'0000'0000'0000ULL };
+
+		constexpr std::uint32_t byte_at( std::uint64_t const chunk,
+		                                 std::size_t const n ) noexcept {
+			return static_cast<std::uint32_t>( ( chunk >> ( 8U * n ) ) & 0xFFU );
+		}
+
+		// Chunk n of a JavaScript timestamp with its digits reduced to 0-9 and
+		// its separators cleared.  A separator is checked with one mask compare
+		// and all the digits with one SWAR test
+		constexpr bool load_javascript_chunk( char const *ptr, std::size_t const n,
+		                                      std::uint64_t &digits ) noexcept {
+			auto const chunk = daw::details::load_8chars( ptr + 8U * n );
+			auto const lanes = javascript_digit_lanes[n];
+			digits = ( chunk & lanes ) - ( 0x3030'3030'3030'3030ULL & lanes );
+			return ( ( chunk | javascript_case_fold[n] ) & ~lanes ) ==
+			         javascript_separators[n] and
+			       daw::details::is_8digits( ( chunk & lanes ) |
+			                                 ( 0x3030'3030'3030'3030ULL & ~lanes ) );
+		}
+
+		// Parse a JavaScript timestamp from exactly 24 bytes at ptr.  Neighbouring
+		// digits are combined in place so that every two digit field is a single
+		// byte.  Without Validate the text is trusted like
+		// parse_javascript_timestamp does and the result is always true
+		template<bool Validate>
+		constexpr bool try_parse_javascript_swar( char const *ptr,
+		                                          timestamp_fields &result ) noexcept {
+			std::uint64_t d0 = 0;
+			std::uint64_t d1 = 0;
+			std::uint64_t d2 = 0;
+			bool const is_valid = load_javascript_chunk( ptr, 0, d0 ) &
+			                      load_javascript_chunk( ptr, 1, d1 ) &
+			                      load_javascript_chunk( ptr, 2, d2 );
+			if( Validate and not is_valid ) {
+				return false;
+			}
+			std::uint64_t const pairs[3] = { d0 * 10U + ( d0 >> 8U ),
+			                                 d1 * 10U + ( d1 >> 8U ),
+			                                 d2 * 10U + ( d2 >> 8U ) };
+			auto const y = byte_at( pairs[0], 0 ) * 100U + byte_at( pairs[0], 2 );
+			auto const mo = byte_at( pairs[0], 5 );
+			auto const d = byte_at( pairs[1], 0 );
+			auto const h = byte_at( pairs[1], 3 );
+			auto const mi = byte_at( pairs[1], 6 );
+			auto const s = byte_at( pairs[2], 1 );
+			auto const ms = byte_at( pairs[2], 4 ) * 10U + byte_at( d2, 6 );
+			if constexpr( Validate ) {
+				if( mo < 1 or mo > 12 or d < 1 or
+				    d > last_day_of_month( static_cast<std::int32_t>( y ), mo ) or
+				    h > 23 or mi > 59 or s > 60 ) {
+					return false;
+				}
+			}
+			result.y = static_cast<std::int32_t>( y );
+			result.mo = static_cast<std::uint8_t>( mo );
+			result.d = static_cast<std::uint8_t>( d );
+			result.h = static_cast<std::uint8_t>( h );
+			result.mi = static_cast<std::uint8_t>( mi );
+			result.s = static_cast<std::uint8_t>( s );
+			result.ns = ms * 1'000'000U;
+			result.offset = 0;
+			return true;
+		}
+	} // namespace details
+
+	/// Parse the JavaScript timestamp, YYYY-MM-DDTHH:MM:SS.sssZ, at byte
+	/// field_offset of each of count fixed size records of stride bytes
+	/// starting at records, to out as a count of Unit since the epoch.  The
+	/// records are read in place and PrefetchDistance records ahead are
+	/// prefetched.  Every field must lie within the buffer.  Invalid
+	/// timestamps are written as 0.  With Validate false the fields are
+	/// trusted, as parse_javascript_timestamp does, and no checks are made
+	/// @return the number of invalid timestamps
+	template<typename Unit = std::chrono::milliseconds, bool Validate = true,
+	         std::size_t PrefetchDistance = 16>
+	std::size_t parse_javascript_timestamps_strided( void const *records,
+	                                                 std::size_t const stride,
+	                                                 std::size_t const field_offset,
+	                                                 std::size_t const count,
+	                                                 std::int64_t *out ) noexcept {
+		auto const *field = static_cast<char const *>( records ) + field_offset;
+		std::size_t invalid_count = 0;
+		for( std::size_t n = 0; n < count; ++n, field += stride ) {
+			if( PrefetchDistance > 0 and n + PrefetchDistance < count ) {
+				daw::details::prefetch( field + PrefetchDistance * stride );
+			}
+			details::timestamp_fields fields{ };
+			if( details::try_parse_javascript_swar<Validate>( field, fields ) ) {
+				out[n] = details::to_epoch<Unit>( fields );
+			} else {
+				out[n] = 0;
+				++invalid_count;
+			}
+		}
+		return invalid_count;
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,404 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#if defined( __cpp_impl_coroutine ) and __has_include( <coroutine> )
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <daw/daw_string_view.h>
+
+#include "daw_date_parsing.h"
+#include "daw_incremental_parsing.h"
+
+/// Coroutine interfaces to the parsers.  The coroutines parse a batch of
+/// timestamps between suspensions and yield it as a span, so the cost of a
+/// suspension is spread over the batch rather than paid per record.
+/// Requires C++20 coroutines
+namespace daw::date_parsing {
+	/// A lazily evaluated sequence of T produced in batches.  next_batch
+	/// resumes the coroutine for the next batch, and iterating visits each
+	/// item, resuming only when a batch is used up.  The coroutine may not
+	/// co_await
+	template<typename T>
+	class batch_generator {
+	public:
+		struct promise_type {
+			std::span<T const> m_batch{ };
+			std::exception_ptr m_error{ };
+
+			batch_generator get_return_object( ) noexcept {
+				return batch_generator(
+				  std::coroutine_handle<promise_type>::from_promise( *this ) );
+			}
+
+			std::suspend_always initial_suspend( ) const noexcept {
+				return { };
+			}
+
+			std::suspend_always final_suspend( ) const noexcept {
+				return { };
+			}
+
+			std::suspend_always yield_value( std::span<T const> batch ) noexcept {
+				m_batch = batch;
+				return { };
+			}
+
+			void return_void( ) noexcept {
+				m_batch = { };
+			}
+
+			void unhandled_exception( ) noexcept {
+				m_batch = { };
+				m_error = std::current_exception( );
+			}
+
+			template<typename U>
+			std::suspend_never await_transform( U && ) = delete;
+		};
+
+		class iterator {
+			batch_generator *m_generator = nullptr;
+			std::span<T const> m_batch{ };
+			std::size_t m_index = 0;
+
+		public:
+			using iterator_concept = std::input_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+
+			iterator( ) = default;
+
+			iterator( batch_generator *generator, std::span<T const> batch ) noexcept
+			  : m_generator( generator )
+			  , m_batch( batch ) {}
+
+			T const &operator*( ) const noexcept {
+				return m_batch[m_index];
+			}
+
+			T const *operator->( ) const noexcept {
+				return m_batch.data( ) + m_index;
+			}
+
+			iterator &operator++( ) {
+				if( ++m_index == m_batch.size( ) ) {
+					m_batch = m_generator->next_batch( );
+					m_index = 0;
+				}
+				return *this;
+			}
+
+			void operator++( int ) {
+				++*this;
+			}
+
+			friend bool operator==( iterator const &it,
+			                        std::default_sentinel_t ) noexcept {
+				return it.m_batch.empty( );
+			}
+		};
+
+	private:
+		std::coroutine_handle<promise_type> m_handle{ };
+
+		explicit batch_generator( std::coroutine_handle<promise_type> handle ) noexcept
+		  : m_handle( handle ) {}
+
+	public:
+		batch_generator( batch_generator &&other ) noexcept
+		  : m_handle( std::exchange( other.m_handle, nullptr ) ) {}
+
+		batch_generator &operator=( batch_generator &&rhs ) noexcept {
+			if( this != &rhs ) {
+				if( m_handle ) {
+					m_handle.destroy( );
+				}
+				m_handle = std::exchange( rhs.m_handle, nullptr );
+			}
+			return *this;
+		}
+
+		~batch_generator( ) {
+			if( m_handle ) {
+				m_handle.destroy( );
+			}
+		}
+
+		/// The next batch, valid until the generator is next resumed.  Empty
+		/// once the coroutine has finished
+		std::span<T const> next_batch( ) {
+			while( m_handle and not m_handle.done( ) ) {
+				m_handle.resume( );
+				auto &promise = m_handle.promise( );
+				if( promise.m_error ) {
+					std::rethrow_exception( std::exchange( promise.m_error, nullptr ) );
+				}
+				if( not promise.m_batch.empty( ) ) {
+					return promise.m_batch;
+				}
+			}
+			return { };
+		}
+
+		iterator begin( ) {
+			return iterator( this, next_batch( ) );
+		}
+
+		std::default_sentinel_t end( ) const noexcept {
+			return { };
+		}
+	};
+
+	/// A sequence of batches produced by a coroutine that can co_await, such
+	/// as one reading from a socket with coroutine based I/O.  In a coroutine,
+	/// co_await next_batch( ) gives the next batch, empty at the end
+	template<typename T>
+	class async_batch_generator {
+	public:
+		struct promise_type {
+			std::span<T const> m_batch{ };
+			std::exception_ptr m_error{ };
+			std::coroutine_handle<> m_consumer{ };
+
+			// Suspending at a yield, or at the end, resumes the consumer
+			struct transfer_to_consumer {
+				constexpr bool await_ready( ) const noexcept {
+					return false;
+				}
+
+				std::coroutine_handle<>
+				await_suspend( std::coroutine_handle<promise_type> handle ) noexcept {
+					return handle.promise( ).m_consumer;
+				}
+
+				constexpr void await_resume( ) const noexcept {}
+			};
+
+			async_batch_generator get_return_object( ) noexcept {
+				return async_batch_generator(
+				  std::coroutine_handle<promise_type>::from_promise( *this ) );
+			}
+
+			std::suspend_always initial_suspend( ) const noexcept {
+				return { };
+			}
+
+			transfer_to_consumer final_suspend( ) const noexcept {
+				return { };
+			}
+
+			transfer_to_consumer yield_value( std::span<T const> batch ) noexcept {
+				m_batch = batch;
+				return { };
+			}
+
+			void return_void( ) noexcept {
+				m_batch = { };
+			}
+
+			void unhandled_exception( ) noexcept {
+				m_batch = { };
+				m_error = std::current_exception( );
+			}
+		};
+
+	private:
+		std::coroutine_handle<promise_type> m_handle{ };
+
+		explicit async_batch_generator(
+		  std::coroutine_handle<promise_type> handle ) noexcept
+		  : m_handle( handle ) {}
+
+		struct next_awaiter {
+			std::coroutine_handle<promise_type> m_handle;
+
+			bool await_ready( ) const noexcept {
+				return not m_handle or m_handle.done( );
+			}
+
+			std::coroutine_handle<>
+			await_suspend( std::coroutine_handle<> consumer ) noexcept {
+				m_handle.promise( ).m_consumer = consumer;
+				return m_handle;
+			}
+
+			std::span<T const> await_resume( ) {
+				if( not m_handle ) {
+					return { };
+				}
+				auto &promise = m_handle.promise( );
+				if( promise.m_error ) {
+					std::rethrow_exception( std::exchange( promise.m_error, nullptr ) );
+				}
+				return promise.m_batch;
+			}
+		};
+
+	public:
+		async_batch_generator( async_batch_generator &&other ) noexcept
+		  : m_handle( std::exchange( other.m_handle, nullptr ) ) {}
+
+		async_batch_generator &operator=( async_batch_generator &&rhs ) noexcept {
+			if( this != &rhs ) {
+				if( m_handle ) {
+					m_handle.destroy( );
+				}
+				m_handle = std::exchange( rhs.m_handle, nullptr );
+			}
+			return *this;
+		}
+
+		~async_batch_generator( ) {
+			if( m_handle ) {
+				m_handle.destroy( );
+			}
+		}
+
+		/// An awaitable of the next batch, valid until the generator is next
+		/// resumed.  Empty once the coroutine has finished
+		next_awaiter next_batch( ) noexcept {
+			return next_awaiter{ m_handle };
+		}
+	};
+
+	template<typename Duration = std::chrono::milliseconds>
+	struct offset_timestamp {
+		/// Offset of the start of the line in the buffer
+		std::size_t offset;
+		std::chrono::time_point<std::chrono::system_clock, Duration> time_point;
+	};
+
+	/// Yields the timestamps of the newline separated lines of buffer, with
+	/// the offset of each line, batch_size at a time.  Empty lines and lines
+	/// that are not timestamps are skipped.  buffer must outlive the generator
+	template<typename Duration = std::chrono::milliseconds>
+	batch_generator<offset_timestamp<Duration>>
+	iso8601_lines_generator( daw::string_view buffer,
+	                         std::size_t const batch_size = 256 ) {
+		using time_point_t =
+		  std::chrono::time_point<std::chrono::system_clock, Duration>;
+		auto const capacity = batch_size > 0 ? batch_size : 1U;
+		std::vector<offset_timestamp<Duration>> batch{ };
+		batch.reserve( capacity );
+		std::size_t offset = 0;
+		while( offset < buffer.size( ) ) {
+			auto const *nl = static_cast<char const *>( std::memchr(
+			  buffer.data( ) + offset, '\n', buffer.size( ) - offset ) );
+			auto const last = nl == nullptr
+			                    ? buffer.size( )
+			                    : static_cast<std::size_t>( nl - buffer.data( ) );
+			auto line = daw::string_view( buffer.data( ) + offset, last - offset );
+			if( not line.empty( ) and line.back( ) == '\r' ) {
+				line.remove_suffix( 1 );
+			}
+			details::timestamp_fields fields{ };
+			if( not line.empty( ) and
+			    details::try_parse_iso8601_timestamp( line, fields ) ) {
+				batch.push_back( offset_timestamp<Duration>{
+				  offset, time_point_t( Duration( details::to_epoch<Duration>( fields ) ) ) } );
+				if( batch.size( ) == capacity ) {
+					co_yield batch;
+					batch.clear( );
+				}
+			}
+			offset = last + 1U;
+		}
+		if( not batch.empty( ) ) {
+			co_yield batch;
+		}
+	}
+
+	/// Yields the timestamps of the newline separated text returned, a chunk
+	/// at a time, by reader.next( ), e.g. a file_chunk_reader or a
+	/// decompressing_reader.  A batch is yielded once batch_size or more
+	/// timestamps are parsed and at the end.  reader must outlive the
+	/// generator
+	template<typename Duration = std::chrono::milliseconds, typename Reader>
+	batch_generator<std::chrono::time_point<std::chrono::system_clock, Duration>>
+	iso8601_chunks_generator( Reader &reader, std::size_t const batch_size = 256 ) {
+		using time_point_t =
+		  std::chrono::time_point<std::chrono::system_clock, Duration>;
+		auto parser = incremental_timestamp_parser<Duration>( );
+		std::vector<time_point_t> batch{ };
+		batch.reserve( batch_size );
+		auto const out = [&]( time_point_t tp ) { batch.push_back( tp ); };
+		for( daw::string_view chunk = reader.next( ); not chunk.empty( );
+		     chunk = reader.next( ) ) {
+			parser.feed( chunk, out );
+			if( batch.size( ) >= batch_size ) {
+				co_yield batch;
+				batch.clear( );
+			}
+		}
+		parser.finish( out );
+		if( not batch.empty( ) ) {
+			co_yield batch;
+		}
+	}
+
+	/// Yields the timestamps of the newline separated text from an
+	/// asynchronous byte source.  co_await read_chunk( ) must give the next
+	/// chunk as something convertible to daw::string_view, empty at the end.
+	/// A chunk need only be valid until the following read.  A batch is
+	/// yielded once batch_size or more timestamps are parsed and at the end
+	template<typename Duration = std::chrono::milliseconds, typename ReadChunk>
+	async_batch_generator<
+	  std::chrono::time_point<std::chrono::system_clock, Duration>>
+	iso8601_async_generator( ReadChunk read_chunk,
+	                         std::size_t const batch_size = 256 ) {
+		using time_point_t =
+		  std::chrono::time_point<std::chrono::system_clock, Duration>;
+		auto parser = incremental_timestamp_parser<Duration>( );
+		std::vector<time_point_t> batch{ };
+		batch.reserve( batch_size );
+		auto const out = [&]( time_point_t tp ) { batch.push_back( tp ); };
+		while( true ) {
+			daw::string_view const chunk = co_await read_chunk( );
+			if( chunk.empty( ) ) {
+				break;
+			}
+			parser.feed( chunk, out );
+			if( batch.size( ) >= batch_size ) {
+				co_yield batch;
+				batch.clear( );
+			}
+		}
+		parser.finish( out );
+		if( not batch.empty( ) ) {
+			co_yield batch;
+		}
+	}
+} // namespace daw::date_parsing
+
+#endif
@@ -0,0 +1,199 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+
+#include "daw_date_formatting.h"
+#include "daw_date_parsing.h"
+
+namespace daw::date_parsing {
+	/// Largest output of normalize_iso8601, YYYY-MM-DDTHH:MM:SS.fffffffffZ
+	inline constexpr std::size_t max_normalized_size = 30;
+
+	namespace details {
+		// Apply a UTC offset to the wall clock fields.  The offset is less than a
+		// day, so at most one day is carried into or out of the date
+		constexpr bool apply_offset( timestamp_fields &f ) noexcept {
+			auto minutes = static_cast<std::int32_t>( f.h ) * 60 +
+			               static_cast<std::int32_t>( f.mi ) - f.offset;
+			std::int32_t y = f.y;
+			auto m = static_cast<std::uint32_t>( f.mo );
+			auto d = static_cast<std::uint32_t>( f.d );
+			if( minutes < 0 ) {
+				minutes += 1440;
+				if( --d == 0 ) {
+					if( --m == 0 ) {
+						m = 12;
+						--y;
+					}
+					d = last_day_of_month( y, m );
+				}
+			} else if( minutes >= 1440 ) {
+				minutes -= 1440;
+				if( ++d > last_day_of_month( y, m ) ) {
+					d = 1;
+					if( ++m > 12 ) {
+						m = 1;
+						++y;
+					}
+				}
+			}
+			if( y < 0 or y > 9999 ) {
+				return false;
+			}
+			f.y = y;
+			f.mo = static_cast<std::uint8_t>( m );
+			f.d = static_cast<std::uint8_t>( d );
+			f.h = static_cast<std::uint8_t>( minutes / 60 );
+			f.mi = static_cast<std::uint8_t>( minutes % 60 );
+			f.offset = 0;
+			return true;
+		}
+
+		constexpr bool is_extended_layout( daw::string_view const ts ) noexcept {
+			// The separator at 10 was validated by the parse and is patched to T
+			return ts.size( ) >= 19 and ts[4] == '-' and ts[7] == '-' and
+			       ts[13] == ':' and ts[16] == ':';
+		}
+
+		// The fraction digits of a valid timestamp, at most 9
+		constexpr daw::string_view fraction_digits( daw::string_view ts ) noexcept {
+			auto pos = ts.find_first_of( '.' );
+			if( pos == daw::string_view::npos ) {
+				pos = ts.find_first_of( ',' );
+				if( pos == daw::string_view::npos ) {
+					return daw::string_view( );
+				}
+			}
+			ts.remove_prefix( pos + 1U );
+			std::size_t count = 0;
+			while( count < ts.size( ) and count < 9 and
+			       daw::details::is_digit( ts[count] ) ) {
+				++count;
+			}
+			return ts.substr( 0, count );
+		}
+	} // namespace details
+
+	/// Rewrite an ISO 8601 timestamp as canonical UTC text,
+	/// YYYY-MM-DDTHH:MM:SS[.fraction]Z, without converting to a time point.
+	/// The fraction digits are kept as written, up to 9.  A timestamp that is
+	/// already extended and UTC is copied and patched; otherwise the offset is
+	/// applied to the minutes, hours and days with a carry.  out must have
+	/// room for max_normalized_size characters
+	/// @return the number of characters written, 0 when in is not valid
+	inline std::size_t normalize_iso8601( daw::string_view const in,
+	                                      char *out ) noexcept {
+		details::timestamp_fields fields{ };
+		if( not details::try_parse_iso8601_timestamp( in, fields ) ) {
+			return 0;
+		}
+		if( fields.offset == 0 and details::is_extended_layout( in ) ) {
+			std::memcpy( out, in.data( ), 19 );
+			out[10] = 'T';
+		} else {
+			if( fields.offset != 0 and not details::apply_offset( fields ) ) {
+				return 0;
+			}
+			namespace fmt_impl = ::daw::date_formatting::impl;
+			fmt_impl::put_4digits( out, static_cast<std::uint32_t>( fields.y ) );
+			out[4] = '-';
+			fmt_impl::put_2digits( out + 5, fields.mo );
+			out[7] = '-';
+			fmt_impl::put_2digits( out + 8, fields.d );
+			out[10] = 'T';
+			fmt_impl::put_2digits( out + 11, fields.h );
+			out[13] = ':';
+			fmt_impl::put_2digits( out + 14, fields.mi );
+			out[16] = ':';
+			fmt_impl::put_2digits( out + 17, fields.s );
+		}
+		std::size_t size = 19;
+		auto const frac = details::fraction_digits( in );
+		if( not frac.empty( ) ) {
+			out[size++] = '.';
+			std::memcpy( out + size, frac.data( ), frac.size( ) );
+			size += frac.size( );
+		}
+		out[size++] = 'Z';
+		return size;
+	}
+
+	/// Throws invalid_iso8601_timestamp when timestamp_str is not valid
+	inline std::string normalize_iso8601( daw::string_view const timestamp_str ) {
+		std::string result( max_normalized_size, '\0' );
+		auto const size = normalize_iso8601( timestamp_str, result.data( ) );
+		daw::exception::precondition_check<invalid_iso8601_timestamp>( size > 0 );
+		result.resize( size );
+		return result;
+	}
+
+	/// Batch form over newline separated timestamps.  Each line of in is
+	/// appended to out normalized, or unchanged when it is not a valid
+	/// timestamp
+	/// @return the number of lines normalized
+	inline std::size_t normalize_iso8601_lines( daw::string_view in,
+	                                            std::string &out ) {
+		std::size_t result = 0;
+		auto pos = out.size( );
+		// A normalized line is at most max_normalized_size characters, which can
+		// be longer than the line itself, e.g. 20170102T130405Z grows by 4.  The
+		// loop makes room for that before each line
+		out.resize( pos + in.size( ) + max_normalized_size );
+		while( not in.empty( ) ) {
+			auto const *nl = static_cast<char const *>(
+			  std::memchr( in.data( ), '\n', in.size( ) ) );
+			auto const line_size = nl == nullptr
+			                         ? in.size( )
+			                         : static_cast<std::size_t>( nl - in.data( ) );
+			auto const line = in.substr( 0, line_size );
+			if( out.size( ) < pos + line_size + max_normalized_size + 1U ) {
+				out.resize( ( pos + line_size + max_normalized_size + 1U ) * 2U );
+			}
+			auto const size = normalize_iso8601( line, out.data( ) + pos );
+			if( size > 0 ) {
+				pos += size;
+				++result;
+			} else {
+				std::memcpy( out.data( ) + pos, line.data( ), line_size );
+				pos += line_size;
+			}
+			if( nl != nullptr ) {
+				out[pos++] = '\n';
+				in.remove_prefix( line_size + 1U );
+			} else {
+				break;
+			}
+		}
+		out.resize( pos );
+		return result;
+	}
+} // namespace daw::date_parsing
@@ -0,0 +1,95 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_arrow_column.h"
+
+int main( ) {
+	using namespace std::chrono;
+	std::string const data =
+	  "2018-01-02T01:02:03.343Z"
+	  "2017-01-02T13:14:15-0430"
+	  "not a timestamp"
+	  "20180102T010203.343123+0000"
+	  "2018-02-30T01:02:03Z"
+	  "20180102010203.343Z";
+	std::vector<std::int32_t> const offsets{ 0, 24, 48, 63, 90, 110, 129 };
+	auto const length = offsets.size( ) - 1U;
+
+	auto const ms_col = daw::date_parsing::parse_iso8601_column<milliseconds>(
+	  offsets.data( ), data.data( ), length );
+	daw::expecting( ms_col.size( ), length );
+	daw::expecting( ms_col.null_count, 2U );
+	daw::expecting( ms_col.validity[0], std::uint8_t{ 0b10'1011 } );
+	daw::expecting( ms_col[0], daw::date_parsing::parse_iso8601_timestamp(
+	                             "2018-01-02T01:02:03.343Z" ) );
+	daw::expecting( ms_col[1], daw::date_parsing::parse_iso8601_timestamp(
+	                             "2017-01-02T13:14:15-0430" ) );
+	daw::expecting( ms_col[3], ms_col[0] );
+	// The basic layout without a date/time separator
+	daw::expecting( ms_col[5], ms_col[0] );
+	daw::expecting( ms_col.values[2], 0 );
+
+	auto const us_col = daw::date_parsing::parse_iso8601_column<microseconds>(
+	  offsets.data( ), data.data( ), length );
+	daw::expecting( us_col.values[3], 1514854923343123 );
+
+	std::vector<std::int64_t> const large_offsets( offsets.begin( ),
+	                                               offsets.end( ) );
+	std::uint8_t const input_validity = 0b11'1110;
+	auto const large_col = daw::date_parsing::parse_iso8601_column<seconds>(
+	  large_offsets.data( ), data.data( ), length, &input_validity );
+	daw::expecting( large_col.null_count, 3U );
+	daw::expecting( large_col.is_valid( 0 ), false );
+	daw::expecting( large_col.values[1], 1483379055 );
+
+	ArrowArray array{ };
+	ArrowSchema schema{ };
+	auto exported = ms_col;
+	daw::date_parsing::export_timestamp_column( std::move( exported ), &array,
+	                                            &schema, "ts" );
+	daw::expecting( std::string( schema.format ), std::string( "tsm:UTC" ) );
+	daw::expecting( std::string( schema.name ), std::string( "ts" ) );
+	daw::expecting( array.length, static_cast<std::int64_t>( length ) );
+	daw::expecting( array.null_count, 2 );
+	daw::expecting( array.n_buffers, 2 );
+	daw::expecting(
+	  static_cast<std::int64_t const *>( array.buffers[1] )[1],
+	  ms_col.values[1] );
+	array.release( &array );
+	schema.release( &schema );
+	daw::expecting( array.release == nullptr, true );
+	daw::expecting( schema.release == nullptr, true );
+
+	std::cout << "arrow column tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -20,17 +20,36 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
 #include <cstdlib>
 #include <date/date.h>
 #include <fstream>
 #include <string>
 #include <vector>
 
+// The cold file benchmarks use posix_fadvise and daw_file_ingest.h, which
+// are POSIX only
+#if defined( __unix__ ) or defined( __APPLE__ )
+#define DAW_ISO8601_BENCH_COLD_FILES
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <daw/daw_benchmark.h>
 #include <daw/daw_memory_mapped_file.h>
 #include <daw/daw_utility.h>
 
+#include "daw/iso8601/daw_date_formatting.h"
 #include "daw/iso8601/daw_date_parsing.h"
+#include "daw/iso8601/daw_dictionary_column.h"
+#if defined( DAW_ISO8601_BENCH_COLD_FILES )
+#include "daw/iso8601/daw_file_ingest.h"
+#endif
+#include "daw/iso8601/daw_incremental_parsing.h"
+#include "daw/iso8601/daw_scattered_parsing.h"
+#include "daw/iso8601/daw_timestamp_normalizing.h"
+
+#include "corpus_generator.h"
 
 date::sys_time<std::chrono::milliseconds> parse8601( std::string const &ts ) {
 	std::istringstream in{ ts };
@@ -88,6 +107,48 @@ int main( int argc, char **argv ) {
 		  return static_cast<uintmax_t>( result );
 	  };
 
+	auto const bench_iso8601_to_epoch =
+	  []( std::vector<std::string> const &timestamps ) {
+		  long long result = 0;
+		  for( auto const &ts : timestamps ) {
+			  result += daw::date_parsing::parse_iso8601_timestamp_to_epoch( ts );
+		  }
+		  return static_cast<uintmax_t>( result );
+	  };
+
+	auto const bench_iso8601_to_epoch_batch =
+	  []( std::vector<std::string> const &timestamps ) {
+		  std::vector<std::int64_t> values( timestamps.size( ) );
+		  daw::date_parsing::parse_iso8601_timestamps_to_epoch(
+		    timestamps.begin( ), timestamps.end( ), values.data( ) );
+		  long long result = 0;
+		  for( auto const v : values ) {
+			  result += v;
+		  }
+		  return static_cast<uintmax_t>( result );
+	  };
+
+	auto const bench_iso8601_scattered =
+	  []( std::vector<std::string> const &timestamps ) {
+		  std::vector<std::int64_t> values( timestamps.size( ) );
+		  daw::date_parsing::parse_iso8601_timestamps_scattered( timestamps,
+		                                                         values.data( ) );
+		  long long result = 0;
+		  for( auto const v : values ) {
+			  result += v;
+		  }
+		  return static_cast<uintmax_t>( result );
+	  };
+
+	auto const bench_javascript_to_epoch =
+	  []( std::vector<std::string> const &timestamps ) {
+		  long long result = 0;
+		  for( auto const &ts : timestamps ) {
+			  result += daw::date_parsing::parse_javascript_timestamp_to_epoch( ts );
+		  }
+		  return static_cast<uintmax_t>( result );
+	  };
+
 	auto const bench_iso8601_parser2 =
 	  []( std::vector<std::string> const &timestamps ) {
 		  long long result = 0;
@@ -117,7 +178,178 @@ int main( int argc, char **argv ) {
 		  return static_cast<uintmax_t>( result );
 	  };
 
-	assert( argc > 1 );
+	// The normalized date and time fields are compared, the fraction width
+	// differs between the two
+	auto const bench_normalizer =
+	  []( std::vector<std::string> const &timestamps ) {
+		  uintmax_t result = 0;
+		  char buff[daw::date_parsing::max_normalized_size];
+		  for( auto const &ts : timestamps ) {
+			  daw::date_parsing::normalize_iso8601(
+			    daw::string_view( ts.data( ), ts.size( ) ), buff );
+			  for( std::size_t n = 0; n < 19; ++n ) {
+				  result += static_cast<unsigned char>( buff[n] );
+			  }
+		  }
+		  return result;
+	  };
+
+	auto const bench_parse_format =
+	  []( std::vector<std::string> const &timestamps ) {
+		  uintmax_t result = 0;
+		  for( auto const &ts : timestamps ) {
+			  auto const str = daw::date_formatting::fmt_javascript_timestamp(
+			    daw::date_parsing::parse_iso8601_timestamp(
+			      daw::string_view( ts.data( ), ts.size( ) ) ) );
+			  for( std::size_t n = 0; n < 19; ++n ) {
+				  result += static_cast<unsigned char>( str[n] );
+			  }
+		  }
+		  return result;
+	  };
+
+	struct string_column {
+		std::string data{ };
+		std::vector<std::int64_t> offsets{ 0 };
+	};
+
+	auto const bench_plain_column = []( string_column const &column ) {
+		auto const result = daw::date_parsing::parse_iso8601_column(
+		  column.offsets.data( ), column.data.data( ), column.offsets.size( ) - 1U );
+		uintmax_t sum = 0;
+		for( std::size_t n = 0; n < result.size( ); ++n ) {
+			sum += static_cast<uintmax_t>( result.values[n] );
+		}
+		return sum;
+	};
+
+	auto const bench_dictionary_column = []( string_column const &column ) {
+		auto const result = daw::date_parsing::parse_iso8601_dictionary_column(
+		  column.offsets.data( ), column.data.data( ), column.offsets.size( ) - 1U );
+		uintmax_t sum = 0;
+		for( std::size_t n = 0; n < result.size( ); ++n ) {
+			sum += static_cast<uintmax_t>( result.value( n ) );
+		}
+		return sum;
+	};
+
+#if defined( DAW_ISO8601_BENCH_COLD_FILES )
+	// Drop the pages of the file from the page cache so that each run reads
+	// it from the device
+	auto const evict_file = []( char const *path ) {
+		auto const fd = ::open( path, O_RDONLY );
+		if( fd >= 0 ) {
+			(void)::posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED );
+			::close( fd );
+		}
+	};
+
+	auto const bench_cold_mmap = [&]( char const *path ) {
+		evict_file( path );
+		daw::filesystem::memory_mapped_file_t<char> file( path );
+		auto parser = daw::date_parsing::incremental_timestamp_parser<>( );
+		long long result = 0;
+		auto const out = [&]( auto tp ) {
+			result += tp.time_since_epoch( ).count( );
+		};
+		parser.feed( daw::string_view( file.data( ), file.size( ) ), out );
+		parser.finish( out );
+		return static_cast<uintmax_t>( result );
+	};
+
+	auto const bench_cold_ingest = [&]( char const *path ) {
+		evict_file( path );
+		long long result = 0;
+		(void)daw::date_parsing::ingest_iso8601_file(
+		  path, [&]( auto tp ) { result += tp.time_since_epoch( ).count( ); } );
+		return static_cast<uintmax_t>( result );
+	};
+#endif
+
+	auto const bench_incremental = []( std::string const &text ) {
+		auto parser = daw::date_parsing::incremental_timestamp_parser<>( );
+		long long result = 0;
+		parser.feed( daw::string_view( text.data( ), text.size( ) ),
+		             [&]( auto tp ) { result += tp.time_since_epoch( ).count( ); } );
+		return static_cast<uintmax_t>( result );
+	};
+
+	// Every parser over generated corpora.  The parsers that throw see only
+	// the valid records, the rest see all of them and count invalid records
+	// as 0.  Each result is checked against the instants the corpus was made
+	// from
+	for( auto const &profile : daw::corpus::corpus_profiles( 100'000, 1 ) ) {
+		auto const corpus = daw::corpus::generate( profile.options );
+		auto const &all = corpus.timestamps;
+		auto const valid = corpus.valid_timestamps( );
+		auto const expected = static_cast<uintmax_t>( corpus.expected_ms );
+		auto const title = [&]( char const *parser ) {
+			return std::string( profile.name ) + ": " + parser;
+		};
+		std::cout << "Corpus " << profile.name << " with " << all.size( )
+		          << " timestamps, " << corpus.invalid_count << " invalid\n";
+
+		auto const r1 = daw::bench_test2( title( "parse_iso8601_timestamp" ),
+		                                  bench_iso8601_parser, valid.size( ), valid );
+		auto const r2 =
+		  daw::bench_test2( title( "parse_iso8601_timestamp_to_epoch" ),
+		                    bench_iso8601_to_epoch, valid.size( ), valid );
+		auto const r3 =
+		  daw::bench_test2( title( "parse_iso8601_timestamps_to_epoch" ),
+		                    bench_iso8601_to_epoch_batch, all.size( ), all );
+		auto const r4 =
+		  daw::bench_test2( title( "parse_iso8601_timestamps_scattered" ),
+		                    bench_iso8601_scattered, all.size( ), all );
+		daw::expecting( expected, r1.get( ) );
+		daw::expecting( expected, r2.get( ) );
+		daw::expecting( expected, r3.get( ) );
+		daw::expecting( expected, r4.get( ) );
+
+		string_column column{ };
+		std::string text{ };
+		for( auto const &ts : all ) {
+			column.data += ts;
+			column.offsets.push_back( static_cast<std::int64_t>( column.data.size( ) ) );
+			text += ts;
+			text += '\n';
+		}
+		auto const r5 = daw::bench_test2( title( "parse_iso8601_column" ),
+		                                  bench_plain_column, all.size( ), column );
+		auto const r6 =
+		  daw::bench_test2( title( "parse_iso8601_dictionary_column" ),
+		                    bench_dictionary_column, all.size( ), column );
+		auto const r7 = daw::bench_test2( title( "incremental_timestamp_parser" ),
+		                                  bench_incremental, all.size( ), text );
+		daw::expecting( expected, r5.get( ) );
+		daw::expecting( expected, r6.get( ) );
+		daw::expecting( expected, r7.get( ) );
+
+		auto const r8 = daw::bench_test2( title( "normalize_iso8601" ),
+		                                  bench_normalizer, valid.size( ), valid );
+		auto const r9 = daw::bench_test2( title( "parse_and_format" ),
+		                                  bench_parse_format, valid.size( ), valid );
+		daw::expecting( r8.get( ), r9.get( ) );
+
+		// The Javascript parsers only read YYYY-MM-DDTHH:MM:SS.sssZ
+		bool const is_javascript =
+		  std::all_of( valid.begin( ), valid.end( ), []( std::string const &ts ) {
+			  return ts.size( ) == 24 and ts.back( ) == 'Z' and ts[4] == '-';
+		  } );
+		if( is_javascript ) {
+			auto const r10 =
+			  daw::bench_test2( title( "parse_javascript_timestamp" ),
+			                    bench_javascript_parser, valid.size( ), valid );
+			auto const r11 =
+			  daw::bench_test2( title( "parse_javascript_timestamp_to_epoch" ),
+			                    bench_javascript_to_epoch, valid.size( ), valid );
+			daw::expecting( expected, r10.get( ) );
+			daw::expecting( expected, r11.get( ) );
+		}
+	}
+
+	if( argc <= 1 ) {
+		return EXIT_SUCCESS;
+	}
 	{
 		std::cout << "Using Timestamp File: " << argv[1] << '\n';
 		daw::filesystem::memory_mapped_file_t<char> mmf( argv[1] );
@@ -152,6 +384,47 @@ int main( int argc, char **argv ) {
 		auto const r2 = daw::bench_test2( "date_parse", bench_iso8601_parser2,
 		                                  timestamps.size( ), timestamps );
 		assert( r1.get( ) == r2.get( ) );
+		auto const r1e =
+		  daw::bench_test2( "parse_iso8601_timestamp_to_epoch",
+		                    bench_iso8601_to_epoch, timestamps.size( ), timestamps );
+		auto const r1b = daw::bench_test2( "parse_iso8601_timestamps_to_epoch",
+		                                   bench_iso8601_to_epoch_batch,
+		                                   timestamps.size( ), timestamps );
+		daw::expecting( r1.get( ), r1e.get( ) );
+		daw::expecting( r1.get( ), r1b.get( ) );
+		auto const r1s = daw::bench_test2( "parse_iso8601_timestamps_scattered",
+		                                   bench_iso8601_scattered,
+		                                   timestamps.size( ), timestamps );
+		daw::expecting( r1.get( ), r1s.get( ) );
+
+		auto const r3 = daw::bench_test2( "normalize_iso8601", bench_normalizer,
+		                                  timestamps.size( ), timestamps );
+		auto const r4 = daw::bench_test2( "parse_and_format", bench_parse_format,
+		                                  timestamps.size( ), timestamps );
+		daw::expecting( r3.get( ), r4.get( ) );
+
+		string_column column{ };
+		for( auto const &ts : timestamps ) {
+			column.data += ts;
+			column.offsets.push_back( static_cast<std::int64_t>( column.data.size( ) ) );
+		}
+		auto const r5 = daw::bench_test2( "parse_iso8601_column", bench_plain_column,
+		                                  timestamps.size( ), column );
+		auto const r6 =
+		  daw::bench_test2( "parse_iso8601_dictionary_column",
+		                    bench_dictionary_column, timestamps.size( ), column );
+		daw::expecting( r5.get( ), r6.get( ) );
+
+#if defined( DAW_ISO8601_BENCH_COLD_FILES )
+		auto const r7 = daw::bench_test2( "cold memory_mapped_file_t + parse",
+		                                  bench_cold_mmap, timestamps.size( ),
+		                                  argv[1] );
+		auto const r8 = daw::bench_test2( "cold ingest_iso8601_file",
+		                                  bench_cold_ingest, timestamps.size( ),
+		                                  argv[1] );
+		daw::expecting( r1.get( ), r7.get( ) );
+		daw::expecting( r1.get( ), r8.get( ) );
+#endif
 	}
 	if( argc <= 2 ) {
 		return EXIT_SUCCESS;
@@ -194,8 +467,12 @@ int main( int argc, char **argv ) {
 		                                  timestamps.size( ), timestamps );
 		auto const r3 = daw::bench_test2( "sscanf", bench_iso8601_sscanf_parser,
 		                                  timestamps.size( ), timestamps );
+		auto const r4 = daw::bench_test2( "parse_javascript_timestamp_to_epoch",
+		                                  bench_javascript_to_epoch,
+		                                  timestamps.size( ), timestamps );
 		daw::expecting( r1.get( ), r2.get( ) );
 		daw::expecting( r2.get( ), r3.get( ) );
+		daw::expecting( r1.get( ), r4.get( ) );
 	}
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,103 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_compressed_column.h"
+#include "daw/iso8601/daw_date_formatting.h"
+#include "daw/iso8601/daw_date_parsing.h"
+
+int main( ) {
+	using namespace std::chrono;
+	using column_t = daw::date_parsing::compressed_timestamp_column<milliseconds>;
+	using tp_t = column_t::value_type;
+
+	std::vector<tp_t> expected{ };
+	std::uint32_t seed = 7;
+	auto tp = daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T13:14:15.123Z" );
+	for( std::size_t n = 0; n < 100'000; ++n ) {
+		seed = seed * 1664525U + 1013904223U;
+		tp += milliseconds( ( seed >> 8U ) % 50U );
+		expected.push_back( tp );
+	}
+	// Out of order, constant and extreme values must round trip too
+	for( std::size_t n = 0; n < 300; ++n ) {
+		expected.push_back( tp - milliseconds( n % 7U * 1000U ) );
+	}
+	for( std::size_t n = 0; n < 200; ++n ) {
+		expected.push_back( tp );
+	}
+	expected.push_back( tp_t( milliseconds( std::numeric_limits<std::int64_t>::min( ) ) ) );
+	expected.push_back( tp_t( milliseconds( std::numeric_limits<std::int64_t>::max( ) ) ) );
+	expected.push_back( tp_t( milliseconds( 0 ) ) );
+
+	column_t column{ };
+	std::copy( expected.begin( ), expected.end( ), std::back_inserter( column ) );
+	daw::expecting( column.size( ), expected.size( ) );
+	for( std::size_t n = 0; n < expected.size( ); ++n ) {
+		daw::expecting( column[n] == expected[n] );
+	}
+	daw::expecting( column.decode( ) == expected );
+
+	// The batch parsers write straight into the column
+	std::vector<std::string> text{ };
+	for( std::size_t n = 0; n < 10'000; ++n ) {
+		text.push_back(
+		  daw::date_formatting::fmt_javascript_timestamp( expected[n] ) );
+	}
+	text.emplace_back( "not a timestamp" );
+	column_t parsed{ };
+	daw::expecting( daw::date_parsing::parse_iso8601_timestamps_to_epoch(
+	                  text.begin( ), text.end( ), std::back_inserter( parsed ) ),
+	                1U );
+	column_t js_parsed{ };
+	daw::expecting( daw::date_parsing::parse_javascript_timestamps_to_epoch(
+	                  text.begin( ), text.end( ), std::back_inserter( js_parsed ) ),
+	                1U );
+	daw::expecting( parsed.size( ), text.size( ) );
+	daw::expecting( js_parsed.size( ), text.size( ) );
+	for( std::size_t n = 0; n < 10'000; ++n ) {
+		daw::expecting( parsed[n] == expected[n] );
+		daw::expecting( js_parsed[n] == expected[n] );
+	}
+	daw::expecting( parsed[10'000] == tp_t( milliseconds( 0 ) ) );
+
+	// Around a byte per value for millisecond log timestamps
+	auto const plain_size = expected.size( ) * sizeof( tp_t );
+	std::cout << "plain: " << plain_size << " bytes, compressed: "
+	          << column.memory_usage( ) << " bytes\n";
+	daw::expecting( column.memory_usage( ) * 5U < plain_size );
+
+	std::cout << "compressed column tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,186 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_compressed_ingest.h"
+
+namespace {
+	using tp_t =
+	  std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+	void write_file( std::filesystem::path const &path, std::string const &data ) {
+		auto out = std::ofstream( path, std::ios::binary | std::ios::trunc );
+		out.write( data.data( ), static_cast<std::streamsize>( data.size( ) ) );
+	}
+
+#if defined( DAW_ISO8601_HAS_ZLIB )
+	std::string gzip( std::string const &text ) {
+		z_stream stream{ };
+		// 16 selects a gzip header
+		if( deflateInit2( &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+		                  Z_DEFAULT_STRATEGY ) != Z_OK ) {
+			std::abort( );
+		}
+		std::string result( deflateBound( &stream, static_cast<uLong>( text.size( ) ) ),
+		                    '\0' );
+		stream.next_in = reinterpret_cast<Bytef *>( const_cast<char *>( text.data( ) ) );
+		stream.avail_in = static_cast<uInt>( text.size( ) );
+		stream.next_out = reinterpret_cast<Bytef *>( result.data( ) );
+		stream.avail_out = static_cast<uInt>( result.size( ) );
+		if( deflate( &stream, Z_FINISH ) != Z_STREAM_END ) {
+			std::abort( );
+		}
+		result.resize( stream.total_out );
+		deflateEnd( &stream );
+		return result;
+	}
+#endif
+
+#if defined( DAW_ISO8601_HAS_ZSTD )
+	std::string zstd( std::string const &text ) {
+		std::string result( ZSTD_compressBound( text.size( ) ), '\0' );
+		auto const size =
+		  ZSTD_compress( result.data( ), result.size( ), text.data( ), text.size( ), 3 );
+		if( ZSTD_isError( size ) ) {
+			std::abort( );
+		}
+		result.resize( size );
+		return result;
+	}
+#endif
+
+	template<typename Decoder>
+	bool ingest_throws( std::filesystem::path const &path,
+	                    daw::date_parsing::decompress_options const &options ) {
+		try {
+			(void)daw::date_parsing::ingest_compressed_iso8601_file<Decoder>(
+			  path.string( ), []( tp_t ) {}, options );
+		} catch( daw::date_parsing::invalid_compressed_stream const & ) {
+			return true;
+		}
+		return false;
+	}
+
+	// Decompress and parse the compressed form of the two halves of text, as
+	// two members or frames, with a spread of block sizes
+	template<typename Decoder, typename Compress>
+	void test_decoder( Compress compress, std::string const &text,
+	                   std::vector<tp_t> const &expected,
+	                   std::size_t const expected_errors ) {
+		auto const path =
+		  std::filesystem::temp_directory_path( ) / "daw_compressed_ingest_test";
+		auto const half = text.size( ) / 2U;
+		auto const data =
+		  compress( text.substr( 0, half ) ) + compress( text.substr( half ) );
+		write_file( path, data );
+
+		for( bool const threaded : { false, true } ) {
+			for( std::size_t const block_size : { 7U, 100U, 4096U, 256U * 1024U } ) {
+				auto options = daw::date_parsing::decompress_options{ };
+				options.block_size = block_size;
+				options.block_count = 3;
+				options.threaded = threaded;
+				options.input = { 512, 2, 64 };
+				std::vector<tp_t> result{ };
+				auto const r = daw::date_parsing::ingest_compressed_iso8601_file<Decoder>(
+				  path.string( ), [&]( tp_t tp ) { result.push_back( tp ); }, options );
+				daw::expecting( result == expected, true );
+				daw::expecting( r.timestamp_count, expected.size( ) );
+				daw::expecting( r.error_count, expected_errors );
+			}
+
+			// The blocks are the text, in order
+			auto options = daw::date_parsing::decompress_options{ };
+			options.block_size = 1000;
+			options.threaded = threaded;
+			daw::date_parsing::decompressing_reader<Decoder> reader( path.string( ),
+			                                                         options );
+			std::string copy{ };
+			for( auto block = reader.next( ); not block.empty( ); block = reader.next( ) ) {
+				copy.append( block.data( ), block.size( ) );
+			}
+			daw::expecting( copy == text, true );
+
+			// Truncated and corrupt streams
+			write_file( path, data.substr( 0, data.size( ) - 5U ) );
+			daw::expecting( ingest_throws<Decoder>( path, options ), true );
+			write_file( path, data + "garbage" );
+			daw::expecting( ingest_throws<Decoder>( path, options ), true );
+			write_file( path, data );
+		}
+
+		// An empty file is an empty stream
+		write_file( path, "" );
+		auto const r = daw::date_parsing::ingest_compressed_iso8601_file<Decoder>(
+		  path.string( ), []( tp_t ) {} );
+		daw::expecting( r.timestamp_count, 0U );
+		std::filesystem::remove( path );
+	}
+} // namespace
+
+int main( ) {
+	std::vector<std::string> const samples{ "2017-01-02T13:14:15-0430",
+	                                        "2018-01-02T01:02:03.343Z",
+	                                        "20180102T010203.343+0000",
+	                                        "2016-02-29T23:59:59Z\r",
+	                                        "not a timestamp" };
+	std::string text{ };
+	std::vector<tp_t> expected{ };
+	std::size_t expected_errors = 0;
+	for( std::size_t n = 0; n < 20000; ++n ) {
+		auto line = samples[( n * 3U ) % samples.size( )];
+		text += line;
+		text += '\n';
+		if( line == samples.back( ) ) {
+			++expected_errors;
+			continue;
+		}
+		if( line.back( ) == '\r' ) {
+			line.pop_back( );
+		}
+		expected.push_back( daw::date_parsing::parse_iso8601_timestamp( line ) );
+	}
+	(void)expected_errors;
+
+#if defined( DAW_ISO8601_HAS_ZLIB )
+	test_decoder<daw::date_parsing::gzip_decoder>( gzip, text, expected,
+	                                               expected_errors );
+	std::cout << "gzip ";
+#endif
+#if defined( DAW_ISO8601_HAS_ZSTD )
+	test_decoder<daw::date_parsing::zstd_decoder>( zstd, text, expected,
+	                                               expected_errors );
+	std::cout << "zstd ";
+#endif
+	std::cout << "compressed ingest tests passed\n";
+	return EXIT_SUCCESS;
+}
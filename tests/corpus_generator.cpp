@@ -0,0 +1,89 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "corpus_generator.h"
+
+// corpus_generator [--profile <name>] [--count <n>] [--seed <n>]
+//                  [--invalid-per-million <n>]
+//   Write a corpus of timestamps, one per line, to stdout.  The same
+//   arguments always give the same output
+namespace {
+	int usage( ) {
+		std::cerr << "Usage:\n"
+		          << "  corpus_generator [--profile <name>] [--count <n>] [--seed <n>]\n"
+		          << "                   [--invalid-per-million <n>]\n"
+		          << "Profiles:\n ";
+		for( auto const &profile : daw::corpus::corpus_profiles( 0, 0 ) ) {
+			std::cerr << ' ' << profile.name;
+		}
+		std::cerr << '\n';
+		return EXIT_FAILURE;
+	}
+} // namespace
+
+int main( int argc, char **argv ) {
+	std::string profile_name = "mixed";
+	std::size_t count = 100'000;
+	std::uint64_t seed = 1;
+	long long invalid_per_million = -1;
+	for( int n = 1; n < argc; ++n ) {
+		auto const arg = std::string( argv[n] );
+		if( n + 1 >= argc ) {
+			return usage( );
+		}
+		if( arg == "--profile" ) {
+			profile_name = argv[++n];
+		} else if( arg == "--count" ) {
+			count = std::strtoull( argv[++n], nullptr, 10 );
+		} else if( arg == "--seed" ) {
+			seed = std::strtoull( argv[++n], nullptr, 10 );
+		} else if( arg == "--invalid-per-million" ) {
+			invalid_per_million = std::strtoll( argv[++n], nullptr, 10 );
+		} else {
+			return usage( );
+		}
+	}
+	for( auto profile : daw::corpus::corpus_profiles( count, seed ) ) {
+		if( profile_name != profile.name ) {
+			continue;
+		}
+		if( invalid_per_million >= 0 ) {
+			profile.options.invalid_per_million =
+			  static_cast<unsigned>( invalid_per_million );
+		}
+		auto const corpus = daw::corpus::generate( profile.options );
+		for( auto const &ts : corpus.timestamps ) {
+			std::fwrite( ts.data( ), 1, ts.size( ), stdout );
+			std::fputc( '\n', stdout );
+		}
+		std::cerr << corpus.timestamps.size( ) << " timestamps, "
+		          << corpus.invalid_count << " invalid\n";
+		return EXIT_SUCCESS;
+	}
+	return usage( );
+}
@@ -0,0 +1,345 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Deterministic corpora of ISO 8601 timestamps for the benchmarks.  Each
+/// record is built from a known instant, so the expected parse is known
+/// without a reference parser.  The date arithmetic is independent of the
+/// library under test
+namespace daw::corpus {
+	struct corpus_options {
+		std::uint64_t seed = 1;
+		std::size_t count = 100'000;
+		// Random instants in [first_year, last_year] when false, otherwise a
+		// log like sequence starting in first_year that advances by up to
+		// max_step_ms per record
+		bool monotonic = false;
+		std::int32_t first_year = 1970;
+		std::int32_t last_year = 2100;
+		std::int64_t max_step_ms = 100;
+		// Relative weights of the offset forms Z, +HHMM, +HH:MM and a U+2212
+		// minus sign.  Numeric offsets are multiples of 15 minutes within
+		// -12:00 to +14:00
+		unsigned weight_z = 1;
+		unsigned weight_hhmm = 0;
+		unsigned weight_hh_mm = 0;
+		unsigned weight_unicode_minus = 0;
+		// Fraction digits are uniform in [min_fraction, max_fraction]
+		unsigned min_fraction = 3;
+		unsigned max_fraction = 3;
+		// Percent of records in the basic layout, YYYYMMDDTHHMMSS
+		unsigned basic_percent = 0;
+		// Percent of the basic records written without the T, YYYYMMDDHHMMSS
+		unsigned unseparated_percent = 0;
+		// Records per million that are corrupted to be invalid
+		unsigned invalid_per_million = 0;
+	};
+
+	struct corpus {
+		std::vector<std::string> timestamps{ };
+		std::vector<bool> is_valid{ };
+		// Sum of the valid records as milliseconds since the epoch, rounded down
+		long long expected_ms = 0;
+		std::size_t invalid_count = 0;
+		std::size_t size_bytes = 0;
+
+		/// The valid records, for the parsers that throw
+		std::vector<std::string> valid_timestamps( ) const {
+			std::vector<std::string> result{ };
+			result.reserve( timestamps.size( ) - invalid_count );
+			for( std::size_t n = 0; n < timestamps.size( ); ++n ) {
+				if( is_valid[n] ) {
+					result.push_back( timestamps[n] );
+				}
+			}
+			return result;
+		}
+	};
+
+	namespace details {
+		// splitmix64
+		struct random_source {
+			std::uint64_t state;
+
+			std::uint64_t next( ) noexcept {
+				auto z = ( state += 0x9E37'79B9'7F4A'7C15ULL );
+				z = ( z ^ ( z >> 30U ) ) * 0xBF58'476D'1CE4'E5B9ULL;
+				z = ( z ^ ( z >> 27U ) ) * 0x94D0'49BB'1331'11EBULL;
+				return z ^ ( z >> 31U );
+			}
+
+			// Uniform in [0, bound), bound > 0
+			std::uint64_t below( std::uint64_t const bound ) noexcept {
+				return next( ) % bound;
+			}
+		};
+
+		constexpr std::int64_t floor_div( std::int64_t const a,
+		                                  std::int64_t const b ) noexcept {
+			return a / b - static_cast<std::int64_t>( ( a % b ) < 0 );
+		}
+
+		// Howard Hinnant's days_from_civil and civil_from_days
+		constexpr std::int64_t days_from_civil( std::int64_t y, unsigned const m,
+		                                        unsigned const d ) noexcept {
+			y -= static_cast<std::int64_t>( m <= 2 );
+			auto const era = floor_div( y, 400 );
+			auto const yoe = static_cast<unsigned>( y - era * 400 );
+			auto const doy = ( 153U * ( m + ( m > 2 ? -3 : 9 ) ) + 2U ) / 5U + d - 1U;
+			auto const doe = yoe * 365U + yoe / 4U - yoe / 100U + doy;
+			return era * 146097 + static_cast<std::int64_t>( doe ) - 719468;
+		}
+
+		struct civil {
+			std::int64_t y;
+			unsigned m;
+			unsigned d;
+		};
+
+		constexpr civil civil_from_days( std::int64_t z ) noexcept {
+			z += 719468;
+			auto const era = floor_div( z, 146097 );
+			auto const doe = static_cast<unsigned>( z - era * 146097 );
+			auto const yoe = ( doe - doe / 1460U + doe / 36524U - doe / 146096U ) / 365U;
+			auto const doy = doe - ( 365U * yoe + yoe / 4U - yoe / 100U );
+			auto const mp = ( 5U * doy + 2U ) / 153U;
+			auto const d = doy - ( 153U * mp + 2U ) / 5U + 1U;
+			auto const m = mp < 10U ? mp + 3U : mp - 9U;
+			return { static_cast<std::int64_t>( yoe ) + era * 400 +
+			           static_cast<std::int64_t>( m <= 2U ),
+			         m, d };
+		}
+
+		inline void put_digits( std::string &out, std::uint64_t value,
+		                        unsigned const width ) {
+			char buff[20];
+			for( unsigned n = width; n > 0; --n ) {
+				buff[n - 1U] = static_cast<char>( '0' + value % 10U );
+				value /= 10U;
+			}
+			out.append( buff, width );
+		}
+
+		constexpr std::int64_t pow10( unsigned const exp ) noexcept {
+			std::int64_t result = 1;
+			for( unsigned n = 0; n < exp; ++n ) {
+				result *= 10;
+			}
+			return result;
+		}
+
+		// Make a valid record invalid in one of several ways
+		// time_pos is the position of the first hour digit
+		inline void corrupt( std::string &ts, bool const basic,
+		                     std::size_t const time_pos, random_source &rng ) {
+			auto const month_pos = basic ? 4U : 5U;
+			switch( rng.below( 4 ) ) {
+			case 0:
+				// Month 13
+				ts[month_pos] = '1';
+				ts[month_pos + 1U] = '3';
+				break;
+			case 1:
+				// A letter in place of a digit of the time
+				ts[time_pos + 1U] = 'x';
+				break;
+			case 2:
+				// Cut inside the time
+				ts.resize( time_pos + ( basic ? 1U : 3U ) );
+				break;
+			default:
+				// Hour 25
+				ts[time_pos] = '2';
+				ts[time_pos + 1U] = '5';
+				break;
+			}
+		}
+	} // namespace details
+
+	inline corpus generate( corpus_options const &opts ) {
+		auto rng = details::random_source{ opts.seed };
+		corpus result{ };
+		result.timestamps.reserve( opts.count );
+		result.is_valid.reserve( opts.count );
+		constexpr std::int64_t ns_per_day = 86'400'000'000'000;
+		auto const first_ns = details::days_from_civil( opts.first_year, 1, 1 ) * ns_per_day;
+		auto const last_ns =
+		  details::days_from_civil( opts.last_year + 1, 1, 1 ) * ns_per_day;
+		auto const weight_total = opts.weight_z + opts.weight_hhmm +
+		                          opts.weight_hh_mm + opts.weight_unicode_minus;
+		auto instant_ns = first_ns;
+		for( std::size_t n = 0; n < opts.count; ++n ) {
+			if( opts.monotonic ) {
+				instant_ns += static_cast<std::int64_t>( rng.below(
+				                static_cast<std::uint64_t>( opts.max_step_ms ) * 1'000'000U +
+				                1U ) );
+			} else {
+				instant_ns = first_ns + static_cast<std::int64_t>( rng.below(
+				                          static_cast<std::uint64_t>( last_ns - first_ns ) ) );
+			}
+			auto const fraction_digits =
+			  opts.min_fraction +
+			  static_cast<unsigned>( rng.below( opts.max_fraction - opts.min_fraction + 1U ) );
+			auto const scale = details::pow10( 9U - fraction_digits );
+			// The text holds the instant truncated to its fraction digits
+			auto const utc_ns = details::floor_div( instant_ns, scale ) * scale;
+
+			auto form = rng.below( weight_total > 0 ? weight_total : 1U );
+			std::int64_t offset_min = 0;
+			int offset_form = 0;
+			if( form >= opts.weight_z ) {
+				form -= opts.weight_z;
+				offset_form = form < opts.weight_hhmm                      ? 1
+				              : form < opts.weight_hhmm + opts.weight_hh_mm ? 2
+				                                                             : 3;
+				offset_min = ( static_cast<std::int64_t>( rng.below( 105 ) ) - 48 ) * 15;
+			}
+			bool const basic = rng.below( 100 ) < opts.basic_percent;
+			bool const unseparated =
+			  basic and rng.below( 100 ) < opts.unseparated_percent;
+
+			auto const local_ns = utc_ns + offset_min * 60'000'000'000;
+			auto const days = details::floor_div( local_ns, ns_per_day );
+			auto const ns_of_day = local_ns - days * ns_per_day;
+			auto const secs = static_cast<std::uint64_t>( ns_of_day / 1'000'000'000 );
+			auto const ymd = details::civil_from_days( days );
+
+			std::string ts{ };
+			details::put_digits( ts, static_cast<std::uint64_t>( ymd.y ), 4 );
+			if( not basic ) {
+				ts += '-';
+			}
+			details::put_digits( ts, ymd.m, 2 );
+			if( not basic ) {
+				ts += '-';
+			}
+			details::put_digits( ts, ymd.d, 2 );
+			if( not unseparated ) {
+				ts += 'T';
+			}
+			auto const time_pos = ts.size( );
+			details::put_digits( ts, secs / 3600U, 2 );
+			if( not basic ) {
+				ts += ':';
+			}
+			details::put_digits( ts, ( secs / 60U ) % 60U, 2 );
+			if( not basic ) {
+				ts += ':';
+			}
+			details::put_digits( ts, secs % 60U, 2 );
+			if( fraction_digits > 0 ) {
+				ts += '.';
+				details::put_digits(
+				  ts, static_cast<std::uint64_t>( ( ns_of_day % 1'000'000'000 ) / scale ),
+				  fraction_digits );
+			}
+			if( offset_form == 0 ) {
+				ts += 'Z';
+			} else {
+				if( offset_min < 0 ) {
+					ts += offset_form == 3 ? "\xE2\x88\x92" : "-";
+				} else {
+					ts += '+';
+				}
+				auto const abs_min =
+				  static_cast<std::uint64_t>( offset_min < 0 ? -offset_min : offset_min );
+				details::put_digits( ts, abs_min / 60U, 2 );
+				if( offset_form == 2 or ( offset_form == 3 and not basic ) ) {
+					ts += ':';
+				}
+				details::put_digits( ts, abs_min % 60U, 2 );
+			}
+
+			bool const is_valid =
+			  rng.below( 1'000'000 ) >= opts.invalid_per_million;
+			if( is_valid ) {
+				result.expected_ms += details::floor_div( utc_ns, 1'000'000 );
+			} else {
+				details::corrupt( ts, basic, time_pos, rng );
+				++result.invalid_count;
+			}
+			result.size_bytes += ts.size( );
+			result.timestamps.push_back( std::move( ts ) );
+			result.is_valid.push_back( is_valid );
+		}
+		return result;
+	}
+
+	struct corpus_profile {
+		char const *name;
+		corpus_options options;
+	};
+
+	/// The corpora the benchmarks run every parser over
+	inline std::vector<corpus_profile> corpus_profiles( std::size_t const count,
+	                                                    std::uint64_t const seed ) {
+		auto base = corpus_options{ };
+		base.count = count;
+		base.seed = seed;
+
+		auto random = base;
+		random.first_year = 1900;
+		random.last_year = 2100;
+		random.weight_hhmm = 1;
+		random.weight_hh_mm = 1;
+		random.min_fraction = 0;
+		random.max_fraction = 9;
+
+		auto log = base;
+		log.monotonic = true;
+		log.first_year = 2017;
+
+		auto mixed = log;
+		mixed.weight_z = 4;
+		mixed.weight_hhmm = 2;
+		mixed.weight_hh_mm = 2;
+		mixed.weight_unicode_minus = 1;
+		mixed.min_fraction = 0;
+		mixed.max_fraction = 9;
+		mixed.basic_percent = 25;
+		mixed.unseparated_percent = 50;
+
+		auto invalid = mixed;
+		invalid.invalid_per_million = 50'000;
+
+		// Extended layout with Z or +HHMM and milliseconds, as date::parse with
+		// "%FT%T%z" reads, for the timestamps.txt comparison
+		auto date_compatible = random;
+		date_compatible.first_year = 1970;
+		date_compatible.weight_hh_mm = 0;
+		date_compatible.min_fraction = 3;
+		date_compatible.max_fraction = 3;
+
+		return { { "random", random },
+		         { "log", log },
+		         { "mixed", mixed },
+		         { "invalid", invalid },
+		         { "date_compatible", date_compatible } };
+	}
+} // namespace daw::corpus
@@ -0,0 +1,113 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_dictionary_column.h"
+
+struct string_column {
+	std::string data{ };
+	std::vector<std::int32_t> offsets{ 0 };
+
+	void push_back( std::string const &str ) {
+		data += str;
+		offsets.push_back( static_cast<std::int32_t>( data.size( ) ) );
+	}
+
+	std::size_t size( ) const {
+		return offsets.size( ) - 1U;
+	}
+};
+
+int main( ) {
+	using namespace std::chrono;
+	std::vector<std::string> const distinct = {
+	  "2018-01-02T01:02:03.343Z", "2017-01-02T13:14:15-0430", "not a timestamp",
+	  "20180102T010203.343+0000", "" };
+	string_column column{ };
+	for( std::size_t n = 0; n < 1000; ++n ) {
+		column.push_back( distinct[n % distinct.size( )] );
+	}
+	std::vector<std::uint8_t> input_validity( ( column.size( ) + 7U ) / 8U, 0xFF );
+	input_validity[0] = 0xFE;
+
+	auto const dict = daw::date_parsing::parse_iso8601_dictionary_column(
+	  column.offsets.data( ), column.data.data( ), column.size( ),
+	  input_validity.data( ) );
+	auto const plain = daw::date_parsing::parse_iso8601_column(
+	  column.offsets.data( ), column.data.data( ), column.size( ),
+	  input_validity.data( ) );
+	daw::expecting( dict.is_dictionary_encoded );
+	// Equal values with different text are separate entries
+	daw::expecting( dict.dictionary.size( ), 3U );
+	daw::expecting( dict.size( ), plain.size( ) );
+	daw::expecting( dict.null_count, plain.null_count );
+	daw::expecting( dict.validity == plain.validity );
+	for( std::size_t n = 0; n < dict.size( ); ++n ) {
+		if( plain.is_valid( n ) ) {
+			daw::expecting( dict[n], plain[n] );
+		}
+	}
+
+	// More distinct values than the threshold falls back to plain values
+	string_column many{ };
+	for( std::size_t n = 0; n < 100; ++n ) {
+		many.push_back( "2018-01-02T01:02:" + std::to_string( 10 + n % 50 ) + "Z" );
+		many.push_back( distinct[n % distinct.size( )] );
+	}
+	auto const fallback = daw::date_parsing::parse_iso8601_dictionary_column<seconds>(
+	  many.offsets.data( ), many.data.data( ), many.size( ), nullptr,
+	  daw::date_parsing::dictionary_column_options{ 16 } );
+	auto const expected = daw::date_parsing::parse_iso8601_column<seconds>(
+	  many.offsets.data( ), many.data.data( ), many.size( ) );
+	daw::expecting( not fallback.is_dictionary_encoded );
+	daw::expecting( fallback.indices.empty( ) );
+	daw::expecting( fallback.values == expected.values );
+	daw::expecting( fallback.validity == expected.validity );
+	daw::expecting( fallback.null_count, expected.null_count );
+
+	// A column of only null rows has an empty dictionary and null rows read as 0
+	string_column invalid{ };
+	for( std::size_t n = 0; n < 20; ++n ) {
+		invalid.push_back( distinct[2U + 2U * ( n % 2U )] );
+	}
+	auto const all_null = daw::date_parsing::parse_iso8601_dictionary_column(
+	  invalid.offsets.data( ), invalid.data.data( ), invalid.size( ) );
+	daw::expecting( all_null.is_dictionary_encoded );
+	daw::expecting( all_null.dictionary.empty( ) );
+	daw::expecting( all_null.null_count, invalid.size( ) );
+	for( std::size_t n = 0; n < all_null.size( ); ++n ) {
+		daw::expecting( not all_null.is_valid( n ) );
+		daw::expecting( all_null.value( n ), std::int64_t{ 0 } );
+	}
+
+	std::cout << "dictionary column tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_duration_parsing.h"
+
+bool duration_throws( daw::string_view str ) {
+	try {
+		(void)daw::date_parsing::parse_iso8601_duration( str );
+	} catch( invalid_iso8601_duration const & ) {
+		return true;
+	}
+	return false;
+}
+
+bool interval_throws( daw::string_view str ) {
+	try {
+		(void)daw::date_parsing::parse_iso8601_interval( str );
+	} catch( invalid_iso8601_interval const & ) {
+		return true;
+	}
+	return false;
+}
+
+int main( ) {
+	using namespace std::chrono;
+	using daw::date_parsing::parse_iso8601_duration;
+	using daw::date_parsing::parse_iso8601_interval;
+	using daw::date_parsing::parse_iso8601_timestamp;
+
+	static_assert( parse_iso8601_duration( "P1DT2H30M" ) ==
+	               date::days( 1 ) + hours( 2 ) + minutes( 30 ) );
+	static_assert( parse_iso8601_duration( "PT1H" ) == hours( 1 ) );
+	static_assert( parse_iso8601_duration( "PT0.5S" ) == milliseconds( 500 ) );
+	static_assert( parse_iso8601_duration( "PT0,25H" ) == minutes( 15 ) );
+	static_assert( parse_iso8601_duration( "P2W" ) == date::days( 14 ) );
+	static_assert( parse_iso8601_duration( "P1Y" ) == date::years( 1 ) );
+	static_assert( parse_iso8601_duration( "P1M" ) == date::months( 1 ) );
+	static_assert( parse_iso8601_duration( "P1MT1M" ) ==
+	               date::months( 1 ) + minutes( 1 ) );
+	static_assert( parse_iso8601_duration( "-PT90S" ) == -seconds( 90 ) );
+	static_assert( parse_iso8601_duration<nanoseconds>( "PT1.000000001S" ) ==
+	               nanoseconds( 1'000'000'001 ) );
+	static_assert( parse_iso8601_duration<seconds>( "P1.5D" ) == hours( 36 ) );
+
+	daw::expecting( duration_throws( "" ) );
+	daw::expecting( duration_throws( "P" ) );
+	daw::expecting( duration_throws( "PT" ) );
+	daw::expecting( duration_throws( "P1DT" ) );
+	daw::expecting( duration_throws( "1D" ) );
+	daw::expecting( duration_throws( "P1H" ) );
+	daw::expecting( duration_throws( "PT1D" ) );
+	daw::expecting( duration_throws( "P1D1Y" ) );
+	daw::expecting( duration_throws( "P1D1D" ) );
+	daw::expecting( duration_throws( "P1.5DT1H" ) );
+	daw::expecting( duration_throws( "P1" ) );
+	daw::expecting( duration_throws( "P.5D" ) );
+	daw::expecting( duration_throws( "PT1.S" ) );
+	daw::expecting( duration_throws( "P1DTT1H" ) );
+	// Durations that do not fit in the result type
+	daw::expecting( duration_throws( "P999999999999999999Y" ) );
+	daw::expecting( duration_throws( "P999999999999999999M" ) );
+	daw::expecting( duration_throws( "P200000000000000000YT200000000000000000S" ) );
+	daw::expecting( duration_throws( "P300000000000DT1S" ) );
+	static_assert( parse_iso8601_duration<seconds>( "P400Y" ) ==
+	               date::years( 400 ) );
+	bool threw = false;
+	try {
+		(void)parse_iso8601_duration<nanoseconds>( "P400Y" );
+	} catch( invalid_iso8601_duration const & ) {
+		threw = true;
+	}
+	daw::expecting( threw );
+
+	constexpr auto start =
+	  parse_iso8601_timestamp( "2017-01-02T13:14:15Z" );
+	static_assert( parse_iso8601_interval( "2017-01-02T13:14:15Z/PT1H" ).start ==
+	               start );
+	static_assert( parse_iso8601_interval( "2017-01-02T13:14:15Z/PT1H" ).end ==
+	               start + hours( 1 ) );
+	static_assert(
+	  parse_iso8601_interval( "2017-01-02T13:14:15Z/2017-01-03T13:14:15Z" )
+	    .duration( ) == date::days( 1 ) );
+	static_assert(
+	  parse_iso8601_interval( "PT1H/2017-01-02T13:14:15Z" ).start ==
+	  start - hours( 1 ) );
+	// Years and months are calendar arithmetic within an interval, clamped to
+	// the end of the month
+	static_assert( parse_iso8601_interval( "2017-01-31T00:00:00Z/P1M" ).end ==
+	               parse_iso8601_timestamp( "2017-02-28T00:00:00Z" ) );
+	static_assert( parse_iso8601_interval( "2016-02-29T12:00:00Z/P1Y2M" ).end ==
+	               parse_iso8601_timestamp( "2017-04-29T12:00:00Z" ) );
+	static_assert( parse_iso8601_interval( "P1Y/2017-03-01T00:00:00Z" ).start ==
+	               parse_iso8601_timestamp( "2016-03-01T00:00:00Z" ) );
+	static_assert( parse_iso8601_interval( "P13M/1970-01-15T00:00:00Z" ).start ==
+	               parse_iso8601_timestamp( "1968-12-15T00:00:00Z" ) );
+	static_assert(
+	  parse_iso8601_interval( "2017-01-02T13:14:15Z/PT1H" ).contains( start ) );
+	static_assert( not parse_iso8601_interval( "2017-01-02T13:14:15Z/PT1H" )
+	                     .contains( start + hours( 1 ) ) );
+
+	daw::expecting( interval_throws( "" ) );
+	daw::expecting( interval_throws( "2017-01-02T13:14:15Z" ) );
+	daw::expecting( interval_throws( "2017-01-02T13:14:15Z/" ) );
+	daw::expecting( interval_throws( "PT1H/PT1H" ) );
+	daw::expecting( interval_throws( "2017-01-03T13:14:15Z/2017-01-02T13:14:15Z" ) );
+	daw::expecting( interval_throws( "2017-01-02T13:14:15Z/-PT1H" ) );
+	daw::expecting( interval_throws( "2017-01-02T13:14:15Z/P3000000000Y" ) );
+	daw::expecting( interval_throws( "2017-01-02T13:14:15Z/P300000000000D" ) );
+
+	// Arrays stop at their first nul, or at their extent without one
+	char padded[48] = "2017-01-02T13:14:15Z/PT1H";
+	daw::expecting( parse_iso8601_interval( padded ).end == start + hours( 1 ) );
+	char duration_padded[16] = "PT1H";
+	daw::expecting( parse_iso8601_duration( duration_padded ) == hours( 1 ) );
+	char const unterminated[4] = { 'P', 'T', '1', 'M' };
+	daw::expecting( parse_iso8601_duration( unterminated ) == minutes( 1 ) );
+
+	std::vector<std::string> const durations = { "PT1S", "bad", "P1D" };
+	std::vector<milliseconds> parsed{ };
+	auto const invalid_count = daw::date_parsing::parse_iso8601_durations(
+	  durations.begin( ), durations.end( ), std::back_inserter( parsed ) );
+	daw::expecting( invalid_count == 1U );
+	daw::expecting( parsed.size( ) == 3U );
+	daw::expecting( parsed[0] == seconds( 1 ) );
+	daw::expecting( parsed[1] == milliseconds( 0 ) );
+	daw::expecting( parsed[2] == date::days( 1 ) );
+
+	std::vector<std::string> const intervals = {
+	  "2017-01-02T13:14:15Z/PT1H", "PT1H" };
+	std::vector<daw::date_parsing::iso8601_interval<>> parsed_intervals( 2 );
+	daw::expecting( daw::date_parsing::parse_iso8601_intervals(
+	                  intervals.begin( ), intervals.end( ),
+	                  parsed_intervals.begin( ) ) == 1U );
+	daw::expecting( parsed_intervals[0].end == start + hours( 1 ) );
+	daw::expecting( parsed_intervals[1].duration( ) == milliseconds( 0 ) );
+
+	std::cout << "duration parsing tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_epoch_parsing.h"
+
+bool throws( daw::string_view str ) {
+	try {
+		(void)daw::date_parsing::parse_epoch_timestamp( str );
+	} catch( invalid_epoch_timestamp const & ) {
+		return true;
+	}
+	return false;
+}
+
+int main( ) {
+	using namespace std::chrono;
+	using daw::date_parsing::epoch_unit;
+	using daw::date_parsing::parse_any_timestamp;
+	using daw::date_parsing::parse_epoch_timestamp;
+
+	constexpr auto expected =
+	  daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T13:14:15.123Z" );
+	static_assert( parse_epoch_timestamp( "1483362855123" ) == expected );
+	static_assert( parse_epoch_timestamp( "1483362855" ) ==
+	               floor<seconds>( expected ) );
+	static_assert( parse_epoch_timestamp( "1483362855123456" ) == expected );
+	static_assert( parse_epoch_timestamp( "1483362855123456789" ) == expected );
+	static_assert( parse_epoch_timestamp<nanoseconds>( "1483362855123456789" )
+	                 .time_since_epoch( )
+	                 .count( ) == 1483362855123456789 );
+	static_assert( parse_epoch_timestamp( "1483362855123",
+	                                      epoch_unit::seconds ) ==
+	               time_point<system_clock, milliseconds>(
+	                 seconds( 1483362855123 ) ) );
+	static_assert(
+	  parse_epoch_timestamp( "-1500" ).time_since_epoch( ).count( ) == -1'500'000 );
+	static_assert(
+	  parse_epoch_timestamp( "0" ).time_since_epoch( ).count( ) == 0 );
+	static_assert( parse_any_timestamp( "2017-01-02T13:14:15.123Z" ) ==
+	               expected );
+	static_assert( parse_any_timestamp( "20170102T131415.123Z" ) == expected );
+	static_assert( parse_any_timestamp( "1483362855123" ) == expected );
+
+	// Arrays stop at their first nul, or at their extent without one
+	char padded[32] = "1483362855123";
+	daw::expecting( parse_epoch_timestamp( padded ) == expected );
+	daw::expecting( parse_any_timestamp( padded ) == expected );
+	char const unterminated[10] = { '1', '4', '8', '3', '3',
+	                                '6', '2', '8', '5', '5' };
+	daw::expecting( parse_epoch_timestamp( unterminated ) ==
+	                floor<seconds>( expected ) );
+
+	daw::expecting( throws( "" ) );
+	daw::expecting( throws( "-" ) );
+	daw::expecting( throws( "14833628551234567890" ) );
+	daw::expecting( throws( "148336285512345678a" ) );
+	daw::expecting( throws( "1483362855:23" ) );
+	daw::expecting( throws( "9999999999999999999" ) );
+	bool overflowed = false;
+	try {
+		(void)parse_epoch_timestamp( "99999999999999999", epoch_unit::seconds );
+	} catch( invalid_epoch_timestamp const & ) {
+		overflowed = true;
+	}
+	daw::expecting( overflowed );
+
+	// Every length and a digit at every position through the SWAR chunks
+	std::string digits{ };
+	std::int64_t value = 0;
+	for( int n = 1; n <= 19; ++n ) {
+		digits += static_cast<char>( '0' + n % 10 );
+		value = value * 10 + n % 10;
+		auto const tp = parse_epoch_timestamp<nanoseconds>(
+		  daw::string_view( digits.data( ), digits.size( ) ),
+		  epoch_unit::nanoseconds );
+		daw::expecting( tp.time_since_epoch( ).count( ), value );
+		for( std::size_t pos = 0; pos < digits.size( ); ++pos ) {
+			auto bad = digits;
+			bad[pos] = '/';
+			daw::expecting( throws( daw::string_view( bad.data( ), bad.size( ) ) ) );
+			bad[pos] = ':';
+			daw::expecting( throws( daw::string_view( bad.data( ), bad.size( ) ) ) );
+		}
+	}
+
+	std::cout << "epoch parsing tests passed\n";
+	return EXIT_SUCCESS;
+}
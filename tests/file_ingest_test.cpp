@@ -0,0 +1,143 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_file_ingest.h"
+
+namespace {
+	using tp_t =
+	  std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+	void write_file( std::filesystem::path const &path, std::string const &text ) {
+		auto out = std::ofstream( path, std::ios::binary | std::ios::trunc );
+		out.write( text.data( ), static_cast<std::streamsize>( text.size( ) ) );
+	}
+
+	std::vector<tp_t> ingest( std::filesystem::path const &path,
+	                          daw::date_parsing::file_ingest_options const &options,
+	                          std::size_t &error_count ) {
+		std::vector<tp_t> result{ };
+		auto const r = daw::date_parsing::ingest_iso8601_file(
+		  path.string( ), [&]( tp_t tp ) { result.push_back( tp ); }, options );
+		daw::expecting( r.timestamp_count, result.size( ) );
+		error_count = r.error_count;
+		return result;
+	}
+
+	bool open_throws( std::string const &path ) {
+		try {
+			daw::date_parsing::file_chunk_reader reader( path );
+		} catch( daw::date_parsing::file_ingest_error const & ) {
+			return true;
+		}
+		return false;
+	}
+} // namespace
+
+int main( ) {
+	std::vector<std::string> const samples{ "2017-01-02T13:14:15-0430",
+	                                        "2018-01-02T01:02:03.343Z",
+	                                        "20180102T010203.343+0000",
+	                                        "2017-01-02T13:14:15.123456789+04:30",
+	                                        "2016-02-29T23:59:59Z\r",
+	                                        "not a timestamp" };
+	std::string text{ };
+	std::vector<tp_t> expected{ };
+	std::size_t expected_errors = 0;
+	for( std::size_t n = 0; n < 5000; ++n ) {
+		auto const &line = samples[( n * 7U ) % samples.size( )];
+		text += line;
+		text += '\n';
+		auto const sv = daw::string_view( line.data( ), line.size( ) );
+		if( line == samples.back( ) ) {
+			++expected_errors;
+		} else if( line.back( ) == '\r' ) {
+			expected.push_back( daw::date_parsing::parse_iso8601_timestamp(
+			  sv.substr( 0, sv.size( ) - 1U ) ) );
+		} else {
+			expected.push_back( daw::date_parsing::parse_iso8601_timestamp( sv ) );
+		}
+	}
+	// The last line has no newline
+	text += samples[0];
+	expected.push_back( daw::date_parsing::parse_iso8601_timestamp( samples[0] ) );
+
+	auto const path =
+	  std::filesystem::temp_directory_path( ) / "daw_file_ingest_test.log";
+	write_file( path, text );
+
+	// Small buffers split many lines across chunks
+	for( auto const &options : { daw::date_parsing::file_ingest_options{ },
+	                             daw::date_parsing::file_ingest_options{ 100, 2, 64 },
+	                             daw::date_parsing::file_ingest_options{ 1000, 3, 512 },
+	                             daw::date_parsing::file_ingest_options{ 4096, 8, 4096 } } ) {
+		std::size_t error_count = 0;
+		auto const result = ingest( path, options, error_count );
+		daw::expecting( result == expected, true );
+		daw::expecting( error_count, expected_errors );
+	}
+
+	// The chunks are the file, in order
+	{
+		daw::date_parsing::file_chunk_reader reader( path.string( ),
+		                                             { 1000, 3, 512 } );
+		daw::expecting( reader.buffer_size( ), 1024U );
+		daw::expecting( reader.file_size( ), text.size( ) );
+		std::string copy{ };
+		for( auto chunk = reader.next( ); not chunk.empty( ); chunk = reader.next( ) ) {
+			copy.append( chunk.data( ), chunk.size( ) );
+		}
+		daw::expecting( copy == text, true );
+		daw::expecting( reader.next( ).empty( ), true );
+	}
+
+	// Stopping part way through
+	{
+		daw::date_parsing::file_chunk_reader reader( path.string( ),
+		                                             { 100, 2, 64 } );
+		daw::expecting( reader.next( ).size( ), 128U );
+	}
+
+	write_file( path, "" );
+	{
+		std::size_t error_count = 0;
+		daw::expecting( ingest( path, { }, error_count ).empty( ), true );
+		daw::expecting( error_count, 0U );
+	}
+
+	std::filesystem::remove( path );
+	daw::expecting( open_throws( path.string( ) ), true );
+
+	std::cout << "file ingest tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_http_date.h"
+
+bool throws( daw::string_view str ) {
+	try {
+		(void)daw::date_parsing::parse_http_date( str );
+	} catch( invalid_http_date const & ) {
+		return true;
+	}
+	return false;
+}
+
+int main( ) {
+	using namespace std::chrono;
+	using daw::date_parsing::parse_http_date;
+
+	constexpr auto expected =
+	  time_point<system_clock, seconds>( seconds( 784'111'777 ) );
+	static_assert( parse_http_date( "Sun, 06 Nov 1994 08:49:37 GMT" ) == expected );
+	static_assert( parse_http_date( "6 Nov 1994 08:49:37 +0000" ) == expected );
+	static_assert( parse_http_date( "Sun, 6 Nov 1994 03:49:37 -0500" ) ==
+	               expected );
+	static_assert( parse_http_date( "Sun, 06 Nov 1994 08:49 UT" ) ==
+	               expected - seconds( 37 ) );
+	static_assert( parse_http_date<false>( "Mon, 06 Nov 1994 08:49:37 GMT" ) ==
+	               expected );
+
+	daw::expecting( throws( "Mon, 06 Nov 1994 08:49:37 GMT" ) );
+	daw::expecting( throws( "Sun, 06 Nox 1994 08:49:37 GMT" ) );
+	daw::expecting( throws( "Sun, 31 Nov 1994 08:49:37 GMT" ) );
+	daw::expecting( throws( "Sun, 06 Nov 1994 08:49:37 PST" ) );
+	daw::expecting( throws( "Sun, 06 Nov 1994 08:49:37" ) );
+	daw::expecting( throws( "Sun, 06 Nov 1994 08:49:37 " ) );
+
+	// Arrays stop at their first nul
+	char padded[64] = "Sun, 06 Nov 1994 08:49:37 GMT";
+	daw::expecting( parse_http_date( padded ) == expected );
+
+	// Round trip and compare with strftime over a range of dates
+	char buff[64];
+	for( std::int64_t t = -2'000'000'000; t < 4'000'000'000;
+	     t += 86'399 * 7 + 13 ) {
+		auto const tp = time_point<system_clock, seconds>( seconds( t ) );
+		auto const str = daw::date_formatting::fmt_http_date( tp );
+		auto const tt = static_cast<std::time_t>( t );
+		std::tm tm{ };
+		gmtime_r( &tt, &tm );
+		auto const len =
+		  std::strftime( buff, sizeof( buff ), "%a, %d %b %Y %H:%M:%S GMT", &tm );
+		daw::expecting( str, std::string( buff, len ) );
+		daw::expecting(
+		  parse_http_date( daw::string_view( str.data( ), str.size( ) ) ) == tp );
+	}
+
+	daw::date_formatting::http_date_cache cache{ };
+	auto const tp = system_clock::time_point( seconds( 784'111'777 ) );
+	daw::expecting( cache( tp ) ==
+	                daw::string_view( "Sun, 06 Nov 1994 08:49:37 GMT" ) );
+	daw::expecting( cache( tp + milliseconds( 999 ) ) ==
+	                daw::string_view( "Sun, 06 Nov 1994 08:49:37 GMT" ) );
+	daw::expecting( cache( tp + seconds( 1 ) ) ==
+	                daw::string_view( "Sun, 06 Nov 1994 08:49:38 GMT" ) );
+
+	std::cout << "http date tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_incremental_parsing.h"
+
+struct test_iovec {
+	void *iov_base;
+	std::size_t iov_len;
+};
+
+int main( ) {
+	using tp_t =
+	  std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+	std::string const stream =
+	  "2017-01-02T13:14:15-0430\n"
+	  "2017-01-02T13:14:15+0430\r\n"
+	  "\n"
+	  "2018-01-02T01:02:03.343Z\n"
+	  "not a timestamp\n"
+	  "20180102T010203.343+0000\n"
+	  "2017-01-02T13:14:15\xE2\x88\x92"
+	  "04:30\n"
+	  "2017-01-02T13:14:15Z";
+	std::vector<tp_t> const expected{
+	  daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T13:14:15-0430" ),
+	  daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T13:14:15+0430" ),
+	  daw::date_parsing::parse_iso8601_timestamp( "2018-01-02T01:02:03.343Z" ),
+	  daw::date_parsing::parse_iso8601_timestamp( "2018-01-02T01:02:03.343Z" ),
+	  daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T13:14:15-0430" ),
+	  daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T13:14:15Z" ) };
+
+	// Every pair of split points gives the same result as one contiguous feed
+	for( std::size_t a = 0; a <= stream.size( ); ++a ) {
+		for( std::size_t b = a; b <= stream.size( ); b += 3 ) {
+			auto parser = daw::date_parsing::incremental_timestamp_parser<>( );
+			std::vector<tp_t> result{ };
+			auto const out = [&]( tp_t tp ) { result.push_back( tp ); };
+			parser.feed( stream.data( ), a, out );
+			parser.feed( stream.data( ) + a, b - a, out );
+			parser.feed( stream.data( ) + b, stream.size( ) - b, out );
+			parser.finish( out );
+			daw::expecting( result == expected, true );
+			daw::expecting( parser.error_count( ), 1U );
+		}
+	}
+
+	// Byte at a time through scatter/gather buffers
+	std::string copy = stream;
+	std::vector<test_iovec> iov{ };
+	for( auto &c : copy ) {
+		iov.push_back( test_iovec{ &c, 1 } );
+	}
+	auto parser = daw::date_parsing::incremental_timestamp_parser<>( );
+	std::vector<tp_t> result{ };
+	auto const count = parser.feed( iov.data( ), iov.size( ), [&]( tp_t tp ) {
+		result.push_back( tp );
+	} );
+	daw::expecting( count, expected.size( ) - 1U );
+	daw::expecting( parser.pending_size( ), 20U );
+	parser.finish( [&]( tp_t tp ) { result.push_back( tp ); } );
+	daw::expecting( result == expected, true );
+
+	// Overlong records are errors rather than being truncated
+	auto long_parser = daw::date_parsing::incremental_timestamp_parser<>( );
+	auto const long_record = std::string( 100, '2' ) + "\n";
+	long_parser.feed( long_record.substr( 0, 50 ), []( tp_t ) {} );
+	long_parser.feed( long_record.substr( 50 ), []( tp_t ) {} );
+	daw::expecting( long_parser.error_count( ), 1U );
+
+	// Splitting one record at any byte gives the same result as not splitting
+	// it, for records up to max_record_size and for longer ones
+	std::string const longest =
+	  "2017-01-02T13:14:15.12300000000000000000\xE2\x88\x92"
+	  "04:30";
+	daw::expecting(
+	  longest.size( ),
+	  daw::date_parsing::incremental_timestamp_parser<>::max_record_size );
+	std::vector<std::string> const lines = {
+	  longest + "\n", longest + "\r\n",
+	  "2017-01-02T13:14:15.123" + std::string( 30, '0' ) + "Z\n" };
+	std::vector<std::size_t> const parsed_counts = { 1, 1, 0 };
+	for( std::size_t n = 0; n < lines.size( ); ++n ) {
+		auto const &line = lines[n];
+		auto whole = daw::date_parsing::incremental_timestamp_parser<>( );
+		std::vector<tp_t> whole_result{ };
+		whole.feed( line, [&]( tp_t tp ) { whole_result.push_back( tp ); } );
+		daw::expecting( whole_result.size( ), parsed_counts[n] );
+		for( std::size_t a = 0; a <= line.size( ); ++a ) {
+			auto split = daw::date_parsing::incremental_timestamp_parser<>( );
+			std::vector<tp_t> split_result{ };
+			auto const out = [&]( tp_t tp ) { split_result.push_back( tp ); };
+			split.feed( line.substr( 0, a ), out );
+			split.feed( line.substr( a ), out );
+			split.finish( out );
+			daw::expecting( split_result == whole_result, true );
+			daw::expecting( split.error_count( ), whole.error_count( ) );
+		}
+	}
+
+	std::cout << "incremental parsing tests passed\n";
+	return EXIT_SUCCESS;
+}
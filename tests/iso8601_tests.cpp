@@ -20,9 +20,18 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <cstdint>
 #include <cstdlib>
+#include <ctime>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#if __has_include( <span> )
+#include <span>
+#endif
 
+#include "daw/iso8601/daw_date_formatting.h"
 #include "daw/iso8601/daw_date_parsing.h"
 
 int main( ) {
@@ -54,5 +63,261 @@ int main( ) {
 	  daw::date_parsing::parse_javascript_timestamp( "2018-01-02T01:02:03.343Z" );
 	std::cout << "2018-01-02T01:02:03.343Z -> " << tp4 << '\n';
 	static_assert( tp4 == tp );
+	static_assert( daw::date_parsing::parse_iso8601_timestamp_to_epoch(
+	                 "2018-01-02T01:02:03.343Z" ) ==
+	               tp.time_since_epoch( ).count( ) );
+	static_assert( daw::date_parsing::parse_iso8601_timestamp_to_epoch<
+	                 nanoseconds>( "2018-01-02T02:02:03.343123456+01:00" ) ==
+	               tp.time_since_epoch( ).count( ) * 1'000'000 + 123'456 );
+	static_assert( daw::date_parsing::parse_iso8601_timestamp_to_epoch<seconds>(
+	                 "1969-12-31T23:59:59.999Z" ) == -1 );
+	static_assert( daw::date_parsing::parse_iso8601_timestamp_to_epoch(
+	                 "20180102010203.343Z" ) ==
+	               daw::date_parsing::parse_iso8601_timestamp( "20180102010203.343Z" )
+	                 .time_since_epoch( )
+	                 .count( ) );
+	static_assert( daw::date_parsing::parse_javascript_timestamp_to_epoch<
+	                 microseconds>( "2018-01-02T01:02:03.343Z" ) ==
+	               tp.time_since_epoch( ).count( ) * 1'000 );
+
+	static_assert( daw::date_parsing::parse_iso8601_bucket<hours>(
+	                 "2018-01-02T01:02:03.343Z" ) ==
+	               floor<hours>( tp ).time_since_epoch( ).count( ) );
+	static_assert( daw::date_parsing::parse_iso8601_bucket<minutes>(
+	                 "20180102010203.343Z" ) ==
+	               floor<minutes>( tp ).time_since_epoch( ).count( ) );
+	static_assert( daw::date_parsing::parse_iso8601_bucket<date::days>(
+	                 "1969-12-31T23:59:59Z" ) == -1 );
+
+	std::vector<std::string> const timestamps = {
+	  "2018-01-02T01:02:03.343Z",      "2018-01-02T01:59:59.999-0030",
+	  "2018-01-01T23:02:03Z",          "2018-01-02T05:02:03.343+05:30",
+	  "2018-01-02 00:00:00.000+01",    "2017-12-31T22:15:00\xE2\x88\x92"
+	                                   "04:45",
+	  "1969-12-31T23:59:59.999Z",      "2018-01-02T01:02:59.999Z",
+	  "2018-01-02T01:45:00Z",          "2018-01-02T13:00:00Z" };
+	for( auto const &ts : timestamps ) {
+		auto const sv = daw::string_view( ts.data( ), ts.size( ) );
+		auto const expected = daw::date_parsing::parse_iso8601_timestamp( sv );
+		auto const check = [&]( auto bucket ) {
+			using bucket_t = decltype( bucket );
+			if( daw::date_parsing::parse_iso8601_bucket<bucket_t>( sv ) !=
+			    floor<bucket_t>( expected ).time_since_epoch( ).count( ) ) {
+				std::cerr << "Bucket mismatch for " << ts << '\n';
+				std::exit( EXIT_FAILURE );
+			}
+		};
+		check( seconds{ } );
+		check( minutes{ } );
+		check( duration<int, std::ratio<900>>{ } );
+		check( hours{ } );
+		check( date::days{ } );
+		// Bucket sizes that are not a whole number of the next larger field
+		check( duration<long long, std::ratio<45>>{ } );
+		check( duration<long long, std::ratio<90 * 60>>{ } );
+		check( duration<long long, std::ratio<36 * 3600>>{ } );
+		check( duration<long long, std::ratio<7 * 86400>>{ } );
+	}
+
+	std::int64_t epochs[10]{ };
+	if( daw::date_parsing::parse_iso8601_timestamps_to_epoch(
+	      timestamps.begin( ), timestamps.end( ), epochs ) != 0 ) {
+		std::cerr << "Unexpected invalid timestamp\n";
+		return EXIT_FAILURE;
+	}
+	for( std::size_t n = 0; n < timestamps.size( ); ++n ) {
+		if( epochs[n] != daw::date_parsing::parse_iso8601_timestamp(
+		                   timestamps[n] )
+		                   .time_since_epoch( )
+		                   .count( ) ) {
+			std::cerr << "Epoch mismatch for " << timestamps[n] << '\n';
+			return EXIT_FAILURE;
+		}
+	}
+	std::vector<std::string> const js_timestamps = {
+	  "2018-01-02T01:02:03.343Z", "2018-01-02T01:02:03Z" };
+	if( daw::date_parsing::parse_javascript_timestamps_to_epoch(
+	      js_timestamps.begin( ), js_timestamps.end( ), epochs ) != 1U or
+	    epochs[0] != tp.time_since_epoch( ).count( ) or epochs[1] != 0 ) {
+		std::cerr << "JavaScript epoch mismatch\n";
+		return EXIT_FAILURE;
+	}
+
+	std::uint64_t counts[3]{ };
+	auto const first_hour =
+	  floor<hours>( tp ).time_since_epoch( ).count( ) - 1;
+	auto const skipped = daw::date_parsing::iso8601_histogram<hours>(
+	  timestamps.begin( ), timestamps.end( ), first_hour, counts, 3 );
+	if( skipped != 6 or counts[0] != 0 or counts[1] != 3 or counts[2] != 1 ) {
+		std::cerr << "Unexpected histogram\n";
+		return EXIT_FAILURE;
+	}
+	std::uint64_t line_counts[2]{ };
+	auto const line_skipped = daw::date_parsing::iso8601_histogram_lines<date::days>(
+	  "2018-01-02T01:02:03Z\r\n\nbad\n2018-01-03T00:00:00+01\n2018-01-03T00:00:00Z",
+	  floor<date::days>( tp ).time_since_epoch( ).count( ), line_counts, 2 );
+	if( line_skipped != 1 or line_counts[0] != 2 or line_counts[1] != 1 ) {
+		std::cerr << "Unexpected line histogram\n";
+		return EXIT_FAILURE;
+	}
+
+	static_assert( daw::date_parsing::parse_iso8601_ordinal_date( "2017-002" ) ==
+	               2017_y / 1 / 2 );
+	static_assert( daw::date_parsing::parse_iso8601_ordinal_date( "2016366" ) ==
+	               2016_y / 12 / 31 );
+	static_assert( daw::date_parsing::parse_iso8601_week_date( "2017-W01-1" ) ==
+	               2017_y / 1 / 2 );
+	static_assert( daw::date_parsing::parse_iso8601_week_date( "2015W537" ) ==
+	               2016_y / 1 / 3 );
+	static_assert( daw::date_parsing::parse_iso8601_week_date( "2009-W01" ) ==
+	               2008_y / 12 / 29 );
+
+	// Every day from 1901 to 2099 must agree with strftime's %j, %G, %g, %V
+	// and %u and round trip through the parsers
+	char expected_buff[32];
+	char ordinal_buff[daw::date_formatting::iso8601_ordinal_date_size];
+	char week_buff[daw::date_formatting::iso8601_week_date_size];
+	for( auto day = date::sys_days{ 1901_y / 1 / 1 };
+	     day < date::sys_days{ 2100_y / 1 / 1 }; day += date::days{ 1 } ) {
+		auto const t = static_cast<std::time_t>(
+		  floor<seconds>( day ).time_since_epoch( ).count( ) );
+		std::tm tm{ };
+		gmtime_r( &t, &tm );
+		std::strftime( expected_buff, sizeof( expected_buff ),
+		               "%Y-%j %G-W%V-%u %g", &tm );
+		daw::date_formatting::fmt_iso8601_ordinal_date( day, ordinal_buff );
+		daw::date_formatting::fmt_iso8601_week_date( day, week_buff );
+		auto const actual =
+		  std::string( ordinal_buff, sizeof( ordinal_buff ) ) + ' ' +
+		  std::string( week_buff, sizeof( week_buff ) ) + ' ' +
+		  daw::date_formatting::fmt_string( "%g", day );
+		auto const ymd = date::year_month_day{ day };
+		if( actual != expected_buff or
+		    daw::date_parsing::parse_iso8601_ordinal_date(
+		      { ordinal_buff, sizeof( ordinal_buff ) } ) != ymd or
+		    daw::date_parsing::parse_iso8601_week_date(
+		      { week_buff, sizeof( week_buff ) } ) != ymd or
+		    // Filled buffers without a nul are read to their extent
+		    daw::date_parsing::parse_iso8601_ordinal_date( ordinal_buff ) != ymd or
+		    daw::date_parsing::parse_iso8601_week_date( week_buff ) != ymd or
+		    daw::date_formatting::fmt_string( "%G %j", day ) !=
+		      std::string( week_buff, 4 ) + ' ' +
+		        std::string( ordinal_buff + 5, 3 ) ) {
+			std::cerr << "Week/ordinal date mismatch: " << actual
+			          << " != " << expected_buff << '\n';
+			return EXIT_FAILURE;
+		}
+	}
+	for( auto const *bad : { "2017-000", "2017-366", "2015-W54-1", "2017-W53-1",
+	                         "2017-W01-8", "2017-W01-1x" } ) {
+		bool threw = false;
+		try {
+			auto const str = daw::string_view( bad );
+			if( str[5] == 'W' ) {
+				(void)daw::date_parsing::parse_iso8601_week_date( str );
+			} else {
+				(void)daw::date_parsing::parse_iso8601_ordinal_date( str );
+			}
+		} catch( invalid_iso8601_timestamp const & ) {
+			threw = true;
+		}
+		if( !threw ) {
+			std::cerr << "Expected " << bad << " to be rejected\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	// char pointers and { ptr, size } convert to daw::string_view as before
+	char const *const ts_ptr = "2018-01-02T01:02:03.343Z";
+	char const date_text[] = "2018-01-02 and more";
+	// A buffer that is not nul terminated is read to its extent
+	char const ts_buff[24] = { '2', '0', '1', '8', '-', '0', '1', '-',
+	                           '0', '2', 'T', '0', '1', ':', '0', '2',
+	                           ':', '0', '3', '.', '3', '4', '3', 'Z' };
+	if( daw::date_parsing::parse_iso8601_timestamp( ts_ptr ) != tp or
+	    daw::date_parsing::parse_iso8601_timestamp_to_epoch( ts_ptr ) !=
+	      tp.time_since_epoch( ).count( ) or
+	    daw::date_parsing::parse_javascript_timestamp( ts_ptr ) != tp or
+	    daw::date_parsing::parse_iso8601_bucket<hours>( ts_ptr ) !=
+	      floor<hours>( tp ).time_since_epoch( ).count( ) or
+	    daw::date_parsing::parse_iso8601_date( { date_text, 10 } ) != dte or
+	    daw::date_parsing::parse_iso8601_timestamp( ts_buff ) != tp or
+	    daw::date_parsing::parse_javascript_timestamp( ts_buff ) != tp ) {
+		std::cerr << "Unexpected result for a char pointer or buffer\n";
+		return EXIT_FAILURE;
+	}
+
+	// Every code unit type and contiguous range is parsed in place
+	static_assert( daw::date_parsing::parse_iso8601_timestamp(
+	                 L"2018-01-02T01:02:03.343Z" ) == tp );
+	static_assert( daw::date_parsing::parse_iso8601_timestamp(
+	                 u"2018-01-02T01:02:03.343Z" ) == tp );
+	static_assert( daw::date_parsing::parse_iso8601_timestamp(
+	                 U"20180102010203.343Z" ) == tp );
+#if defined( __cpp_char8_t )
+	static_assert( daw::date_parsing::parse_iso8601_timestamp(
+	                 u8"2018-01-02T01:02:03.343Z" ) == tp );
+#endif
+	static_assert( daw::date_parsing::parse_javascript_timestamp(
+	                 u"2018-01-02T01:02:03.343Z" ) == tp );
+	static_assert( daw::date_parsing::parse_iso8601_date( U"2018-01-02" ) ==
+	               dte );
+	static_assert( daw::date_parsing::parse_iso8601_time( L"01:02:03.343" ) ==
+	               tme );
+	static_assert( daw::date_parsing::parse_iso8601_week_date( u"2018-W01-2" ) ==
+	               dte );
+	static_assert( daw::date_parsing::parse_iso8601_bucket<hours>(
+	                 std::u16string_view( u"2018-01-02T01:02:03.343Z" ) ) ==
+	               floor<hours>( tp ).time_since_epoch( ).count( ) );
+	// U+2212 MINUS SIGN is a single code unit in UTF-16 and UTF-32
+	static_assert( daw::date_parsing::parse_iso8601_timestamp(
+	                 u"2018-01-02T00:32:03.343\u221200:30" ) == tp );
+	daw::date_parsing::details::timestamp_fields fields{ };
+	// Wide code units that alias digits or separators once truncated to a byte
+	if( daw::date_parsing::details::try_parse_iso8601_timestamp(
+	      daw::basic_string_view<char16_t>( u"2018-01-02T01:02:0\u0133Z" ),
+	      fields ) or
+	    daw::date_parsing::details::try_parse_iso8601_timestamp(
+	      daw::basic_string_view<char32_t>( U"2018-01-02T01:02:03\U0001002BZ" ),
+	      fields ) ) {
+		std::cerr << "Expected truncated code units to be rejected\n";
+		return EXIT_FAILURE;
+	}
+
+	std::string const str_ts = "2018-01-02T01:02:03.343Z";
+	std::u16string const u16_ts = u"2018-01-02T01:02:03.343Z";
+	std::vector<char> const vec_ts( str_ts.begin( ), str_ts.end( ) );
+	if( daw::date_parsing::parse_iso8601_timestamp( str_ts ) != tp or
+	    daw::date_parsing::parse_javascript_timestamp( str_ts ) != tp or
+	    daw::date_parsing::parse_iso8601_timestamp( u16_ts ) != tp or
+	    daw::date_parsing::parse_iso8601_timestamp( vec_ts ) != tp or
+	    daw::date_parsing::parse_iso8601_timestamp( std::string_view( str_ts ) ) !=
+	      tp ) {
+		std::cerr << "Range parse mismatch\n";
+		return EXIT_FAILURE;
+	}
+#if defined( __cpp_lib_span )
+	if( daw::date_parsing::parse_iso8601_timestamp(
+	      std::span<char16_t const>( u16_ts.data( ), u16_ts.size( ) ) ) != tp ) {
+		std::cerr << "Span parse mismatch\n";
+		return EXIT_FAILURE;
+	}
+#endif
+	std::vector<std::u32string> const wide_timestamps = {
+	  U"2018-01-02T01:02:03.343Z", U"2018-01-02T01:59:59Z", U"bad" };
+	std::uint64_t wide_counts[1]{ };
+	if( daw::date_parsing::iso8601_histogram<hours>(
+	      wide_timestamps.begin( ), wide_timestamps.end( ),
+	      floor<hours>( tp ).time_since_epoch( ).count( ), wide_counts, 1 ) !=
+	      1U or
+	    wide_counts[0] != 2U or
+	    daw::date_parsing::iso8601_histogram_lines<hours>(
+	      std::wstring( L"2018-01-02T01:02:03Z\r\n\nbad\n" ),
+	      floor<hours>( tp ).time_since_epoch( ).count( ), wide_counts, 1 ) !=
+	      1U or
+	    wide_counts[0] != 3U ) {
+		std::cerr << "Wide histogram mismatch\n";
+		return EXIT_FAILURE;
+	}
 	return EXIT_SUCCESS;
 }
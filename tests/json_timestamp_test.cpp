@@ -0,0 +1,83 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_json_timestamp.h"
+
+struct Event {
+	daw::date_parsing::json::timestamp_t created;
+	daw::date_parsing::json::timestamp_t updated;
+	daw::date_parsing::json::timestamp_t seen;
+};
+
+namespace daw::json {
+	template<>
+	struct json_data_contract<Event> {
+		static constexpr char const created[] = "created";
+		static constexpr char const updated[] = "updated";
+		static constexpr char const seen[] = "seen";
+		using type = json_member_list<
+		  daw::date_parsing::json::json_iso8601_timestamp<created>,
+		  daw::date_parsing::json::json_javascript_timestamp<updated>,
+		  daw::date_parsing::json::json_iso8601_date<seen>>;
+
+		static inline auto to_json_data( Event const &value ) {
+			return std::forward_as_tuple( value.created, value.updated, value.seen );
+		}
+	};
+} // namespace daw::json
+
+int main( ) {
+	std::string_view const data = R"(
+{
+  "created": "2017-01-02T13:14:15-0430",
+  "updated": "2018-01-02T01:02:03.343Z",
+  "seen": "20180102T010203.343+0000"
+}
+	)";
+	auto const evt = daw::json::from_json<Event>( data );
+	daw::expecting( evt.created, daw::date_parsing::parse_iso8601_timestamp(
+	                               "2017-01-02T13:14:15-0430" ) );
+	daw::expecting( evt.updated, daw::date_parsing::parse_javascript_timestamp(
+	                               "2018-01-02T01:02:03.343Z" ) );
+	daw::expecting( evt.seen, evt.updated );
+
+	auto const json = daw::json::to_json( evt );
+	daw::expecting( json.find( R"("created":"2017-01-02T17:44:15.000Z")" ) !=
+	                  std::string::npos,
+	                true );
+	daw::expecting( json.find( R"("updated":"2018-01-02T01:02:03.343Z")" ) !=
+	                  std::string::npos,
+	                true );
+	auto const evt2 = daw::json::from_json<Event>( json );
+	daw::expecting( evt2.created, evt.created );
+	daw::expecting( evt2.updated, evt.updated );
+	std::cout << json << '\n';
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_lazy_timestamp.h"
+
+using daw::date_parsing::lazy_timestamp;
+
+daw::string_view sv( std::string const &str ) {
+	return daw::string_view( str.data( ), str.size( ) );
+}
+
+int main( ) {
+	std::vector<std::string> const timestamps = {
+	  "2017-01-02T13:14:15.123Z", "2017-01-02T13:14:15.124Z",
+	  "2017-01-02 13:14:16.000Z", "2016-12-31T23:59:59.999Z",
+	  "2017-01-02T13:14:15.123+01:00", "2017-01-02T12:14:15.123Z",
+	  "20170102T131415.123Z",    "2017-01-02T13:14:15Z",
+	  "2017-01-02T08:44:15.123-0430", "2017-01-02T13:14:15.1234Z",
+	  "2017-01-02T13:14:15.1235Z",     "20170102131415.123Z",
+	};
+	// Every pair must order the same way as the parsed values, and pairs with
+	// the same shape and offset must do so without parsing
+	for( auto const &a : timestamps ) {
+		for( auto const &b : timestamps ) {
+			auto const lhs = lazy_timestamp( sv( a ) );
+			auto const rhs = lazy_timestamp( sv( b ) );
+			auto const textual =
+			  lhs.shape( ).layout !=
+			    daw::date_parsing::timestamp_shape::layout_t::unknown and
+			  lhs.shape( ).layout == rhs.shape( ).layout and
+			  lhs.shape( ).offset_pos == rhs.shape( ).offset_pos and
+			  a.substr( lhs.shape( ).offset_pos ) ==
+			    b.substr( rhs.shape( ).offset_pos );
+			auto const a_tp = daw::date_parsing::parse_iso8601_timestamp( sv( a ) );
+			auto const b_tp = daw::date_parsing::parse_iso8601_timestamp( sv( b ) );
+			auto const expected_lt = a_tp < b_tp;
+			auto const expected_eq = a_tp == b_tp;
+			daw::expecting( lhs < rhs, expected_lt );
+			daw::expecting( lhs == rhs, expected_eq );
+			daw::expecting( lhs >= rhs, not expected_lt );
+			daw::expecting( lhs.is_parsed( ), not textual );
+		}
+	}
+
+	auto const bound = lazy_timestamp( "2017-01-02T13:00:00.000Z" );
+	auto const ts = lazy_timestamp( "2017-01-02T13:14:15.123Z" );
+	daw::expecting( ts > bound );
+	daw::expecting( not ts.is_parsed( ) );
+	daw::expecting( ts.value( ) == daw::date_parsing::parse_iso8601_timestamp(
+	                                 "2017-01-02T13:14:15.123Z" ) );
+	daw::expecting( ts.is_parsed( ) );
+	daw::expecting( ts == ts.value( ) );
+
+	// Digits below a millisecond are not kept by value( ), so they are not
+	// compared either and equality stays transitive
+	auto const a = lazy_timestamp( "2017-01-02T13:14:15.1234Z" );
+	auto const b = lazy_timestamp( "2017-01-02T13:14:15.1235Z" );
+	daw::expecting( a == b );
+	daw::expecting( not a.is_parsed( ) );
+	daw::expecting( a == b.value( ) and b == a.value( ) );
+
+	auto const bad = lazy_timestamp( "not a timestamp" );
+	daw::expecting( bad.shape( ).layout ==
+	                daw::date_parsing::timestamp_shape::layout_t::unknown );
+	bool threw = false;
+	try {
+		(void)( bad < ts );
+	} catch( invalid_iso8601_timestamp const & ) { threw = true; }
+	daw::expecting( threw );
+
+	std::cout << "lazy timestamp tests passed\n";
+	return EXIT_SUCCESS;
+}
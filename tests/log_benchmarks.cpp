@@ -0,0 +1,576 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_date_formatting.h"
+#include "daw/iso8601/daw_duration_parsing.h"
+#include "daw/iso8601/daw_http_date.h"
+#include "daw/iso8601/daw_incremental_parsing.h"
+#include "daw/iso8601/daw_log_merge.h"
+#include "daw/iso8601/daw_log_timestamp_parsing.h"
+#include "daw/iso8601/daw_scattered_parsing.h"
+#include "daw/iso8601/daw_strided_parsing.h"
+#include "daw/iso8601/daw_timestamp_generator.h"
+
+// Synthetic per host logs, sorted, with a mix of UTC offsets
+std::vector<std::string> make_host_logs( std::size_t const hosts,
+                                         std::size_t const lines ) {
+	std::vector<std::string> result( hosts );
+	std::uint32_t seed = 1;
+	for( std::size_t h = 0; h < hosts; ++h ) {
+		auto tp = std::chrono::time_point<std::chrono::system_clock,
+		                                  std::chrono::milliseconds>(
+		  std::chrono::milliseconds( 1'483'362'855'000 ) );
+		auto const offset_hours = static_cast<int>( h % 5U ) - 2;
+		auto &log = result[h];
+		log.reserve( lines * 80U );
+		for( std::size_t n = 0; n < lines; ++n ) {
+			seed = seed * 1664525U + 1013904223U;
+			tp += std::chrono::milliseconds( ( seed >> 8U ) % 100U );
+			if( offset_hours == 0 ) {
+				daw::date_formatting::fmt_javascript_timestamp(
+				  tp, std::back_inserter( log ) );
+			} else {
+				auto local = std::string( );
+				daw::date_formatting::fmt_javascript_timestamp(
+				  tp + std::chrono::hours( offset_hours ),
+				  std::back_inserter( local ) );
+				local.pop_back( );
+				log += local;
+				log += offset_hours < 0 ? "-0" : "+0";
+				log += static_cast<char>( '0' + ( offset_hours < 0 ? -offset_hours
+				                                                   : offset_hours ) );
+				log += "00";
+			}
+			log += " host-";
+			log += std::to_string( h );
+			log += " level=info request served in 12ms\n";
+		}
+	}
+	return result;
+}
+
+int main( int argc, char **argv ) {
+	auto const hosts = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 32U;
+	auto const lines = argc > 2 ? std::strtoull( argv[2], nullptr, 10 ) : 50'000U;
+	auto const logs = make_host_logs( hosts, lines );
+	std::size_t total_size = 0;
+	for( auto const &log : logs ) {
+		total_size += log.size( );
+	}
+	std::cout << "Merging " << hosts << " logs of " << lines << " lines, "
+	          << total_size << " bytes\n";
+
+	daw::bench_n_test_mbs<10>(
+	  "merge_sorted_logs", total_size,
+	  [total_size]( std::size_t merged ) { return merged == total_size; },
+	  []( std::vector<std::string> const &inputs ) {
+		  std::size_t merged = 0;
+		  daw::date_parsing::merge_sorted_logs(
+		    inputs, [&]( daw::string_view rec ) { merged += rec.size( ); } );
+		  return merged;
+	  },
+	  logs );
+
+	std::vector<std::string> clf_timestamps{ };
+	std::size_t clf_size = 0;
+	for( std::size_t n = 0; n < 100'000; ++n ) {
+		char buff[32];
+		auto const t = static_cast<std::time_t>( 1'483'362'855 + n * 37 );
+		std::tm tm{ };
+		gmtime_r( &t, &tm );
+		std::strftime( buff, sizeof( buff ), "%d/%b/%Y:%H:%M:%S +0000", &tm );
+		clf_timestamps.emplace_back( buff );
+		clf_size += clf_timestamps.back( ).size( );
+	}
+	// Both are checked against the seconds since the epoch from strftime
+	long long clf_expected = 0;
+	for( std::size_t n = 0; n < clf_timestamps.size( ); ++n ) {
+		clf_expected += 1'483'362'855 + static_cast<long long>( n ) * 37;
+	}
+	daw::bench_n_test_mbs<10>(
+	  "parse_clf_timestamp", clf_size,
+	  [clf_expected]( long long r ) { return r == clf_expected; },
+	  []( std::vector<std::string> const &timestamps ) {
+		  long long result = 0;
+		  for( auto const &ts : timestamps ) {
+			  result += std::chrono::floor<std::chrono::seconds>(
+			              daw::date_parsing::parse_clf_timestamp(
+			                daw::string_view( ts.data( ), ts.size( ) ) ) )
+			              .time_since_epoch( )
+			              .count( );
+		  }
+		  return result;
+	  },
+	  clf_timestamps );
+	daw::bench_n_test_mbs<10>(
+	  "strptime", clf_size,
+	  [clf_expected]( long long r ) { return r == clf_expected; },
+	  []( std::vector<std::string> const &timestamps ) {
+		  long long result = 0;
+		  for( auto const &ts : timestamps ) {
+			  std::tm tm{ };
+			  strptime( ts.c_str( ), "%d/%b/%Y:%H:%M:%S %z", &tm );
+			  result += static_cast<long long>( timegm( &tm ) );
+		  }
+		  return result;
+	  },
+	  clf_timestamps );
+
+	std::vector<std::string> http_dates{ };
+	std::size_t http_size = 0;
+	for( std::size_t n = 0; n < 100'000; ++n ) {
+		http_dates.push_back( daw::date_formatting::fmt_http_date(
+		  std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>(
+		    std::chrono::seconds( 1'483'362'855 + n * 37 ) ) ) );
+		http_size += http_dates.back( ).size( );
+	}
+	daw::bench_n_test_mbs<10>(
+	  "parse_http_date", http_size,
+	  [clf_expected]( long long r ) { return r == clf_expected; },
+	  []( std::vector<std::string> const &dates ) {
+		  long long result = 0;
+		  for( auto const &date : dates ) {
+			  result += daw::date_parsing::parse_http_date(
+			              daw::string_view( date.data( ), date.size( ) ) )
+			              .time_since_epoch( )
+			              .count( );
+		  }
+		  return result;
+	  },
+	  http_dates );
+	daw::bench_n_test_mbs<10>(
+	  "strptime http date", http_size,
+	  [clf_expected]( long long r ) { return r == clf_expected; },
+	  []( std::vector<std::string> const &dates ) {
+		  long long result = 0;
+		  for( auto const &date : dates ) {
+			  std::tm tm{ };
+			  strptime( date.c_str( ), "%a, %d %b %Y %H:%M:%S GMT", &tm );
+			  result += static_cast<long long>( timegm( &tm ) );
+		  }
+		  return result;
+	  },
+	  http_dates );
+
+	// Formatting a Date header for consecutive requests, around 1000 a second
+	auto const request_times = [] {
+		std::vector<std::chrono::system_clock::time_point> result{ };
+		for( std::size_t n = 0; n < 100'000; ++n ) {
+			result.push_back( std::chrono::system_clock::time_point(
+			  std::chrono::milliseconds( 1'483'362'855'000 + n ) ) );
+		}
+		return result;
+	}( );
+	auto const format_size =
+	  request_times.size( ) * daw::date_parsing::http_date_size;
+	auto const format_ok = [format_size]( std::size_t r ) {
+		return r == format_size;
+	};
+	daw::bench_n_test_mbs<10>(
+	  "fmt_http_date", format_size, format_ok,
+	  []( std::vector<std::chrono::system_clock::time_point> const &tps ) {
+		  std::size_t result = 0;
+		  char buff[daw::date_parsing::http_date_size];
+		  for( auto const &tp : tps ) {
+			  daw::date_formatting::fmt_http_date( tp, buff );
+			  daw::do_not_optimize( buff );
+			  result += sizeof( buff );
+		  }
+		  return result;
+	  },
+	  request_times );
+	daw::bench_n_test_mbs<10>(
+	  "http_date_cache", format_size, format_ok,
+	  []( std::vector<std::chrono::system_clock::time_point> const &tps ) {
+		  std::size_t result = 0;
+		  daw::date_formatting::http_date_cache cache{ };
+		  for( auto const &tp : tps ) {
+			  auto const str = cache( tp );
+			  daw::do_not_optimize( str );
+			  result += str.size( );
+		  }
+		  return result;
+	  },
+	  request_times );
+	daw::bench_n_test_mbs<10>(
+	  "strftime", format_size, format_ok,
+	  []( std::vector<std::chrono::system_clock::time_point> const &tps ) {
+		  std::size_t result = 0;
+		  char buff[64];
+		  for( auto const &tp : tps ) {
+			  auto const t = std::chrono::system_clock::to_time_t( tp );
+			  std::tm tm{ };
+			  gmtime_r( &t, &tm );
+			  result += std::strftime( buff, sizeof( buff ),
+			                           "%a, %d %b %Y %H:%M:%S GMT", &tm );
+			  daw::do_not_optimize( buff );
+		  }
+		  return result;
+	  },
+	  request_times );
+
+	std::vector<date::sys_days> week_days{ };
+	for( auto day = date::sys_days{ date::year{ 1970 } / 1 / 1 };
+	     week_days.size( ) < 100'000; day += date::days{ 1 } ) {
+		week_days.push_back( day );
+	}
+	auto const week_size =
+	  week_days.size( ) * daw::date_formatting::iso8601_week_date_size;
+	auto const week_ok = [week_size]( std::size_t r ) { return r == week_size; };
+	daw::bench_n_test_mbs<10>(
+	  "fmt_iso8601_week_date", week_size, week_ok,
+	  []( std::vector<date::sys_days> const &days ) {
+		  std::size_t result = 0;
+		  char buff[daw::date_formatting::iso8601_week_date_size];
+		  for( auto const &day : days ) {
+			  daw::date_formatting::fmt_iso8601_week_date( day, buff );
+			  daw::do_not_optimize( buff );
+			  result += sizeof( buff );
+		  }
+		  return result;
+	  },
+	  week_days );
+	daw::bench_n_test_mbs<10>(
+	  "strftime week date", week_size, week_ok,
+	  []( std::vector<date::sys_days> const &days ) {
+		  std::size_t result = 0;
+		  char buff[32];
+		  for( auto const &day : days ) {
+			  auto const t = static_cast<std::time_t>(
+			    std::chrono::floor<std::chrono::seconds>( day )
+			      .time_since_epoch( )
+			      .count( ) );
+			  std::tm tm{ };
+			  gmtime_r( &t, &tm );
+			  result += std::strftime( buff, sizeof( buff ), "%G-W%V-%u", &tm );
+			  daw::do_not_optimize( buff );
+		  }
+		  return result;
+	  },
+	  week_days );
+
+	std::vector<std::string> week_dates{ };
+	long long week_expected = 0;
+	for( auto const &day : week_days ) {
+		week_dates.push_back( daw::date_formatting::fmt_iso8601_week_date( day ) );
+		week_expected += day.time_since_epoch( ).count( );
+	}
+	daw::bench_n_test_mbs<10>(
+	  "parse_iso8601_week_date", week_size,
+	  [week_expected]( long long r ) { return r == week_expected; },
+	  []( std::vector<std::string> const &dates ) {
+		  long long result = 0;
+		  for( auto const &str : dates ) {
+			  result += date::sys_days( daw::date_parsing::parse_iso8601_week_date(
+			                              daw::string_view( str.data( ), str.size( ) ) ) )
+			              .time_since_epoch( )
+			              .count( );
+		  }
+		  return result;
+	  },
+	  week_dates );
+
+	std::vector<std::string> durations{ };
+	std::vector<std::string> intervals{ };
+	std::vector<std::string> interval_starts{ };
+	std::size_t durations_size = 0;
+	std::size_t intervals_size = 0;
+	long long duration_expected = 0;
+	long long interval_expected = 0;
+	for( std::size_t n = 0; n < 100'000; ++n ) {
+		auto const d = static_cast<long long>( n % 30 );
+		auto const h = static_cast<long long>( n % 24 );
+		auto const m = static_cast<long long>( n % 60 );
+		durations.push_back( "P" + std::to_string( d ) + "DT" + std::to_string( h ) +
+		                     "H" + std::to_string( m ) + "M" );
+		durations_size += durations.back( ).size( );
+		duration_expected += ( ( d * 24 + h ) * 60 + m ) * 60'000;
+		interval_starts.push_back( daw::date_formatting::fmt_javascript_timestamp(
+		  std::chrono::time_point<std::chrono::system_clock,
+		                          std::chrono::milliseconds>(
+		    std::chrono::milliseconds( 1'483'362'855'000 + n * 37'001 ) ) ) );
+		intervals.push_back( interval_starts.back( ) + "/" + durations.back( ) );
+		intervals_size += intervals.back( ).size( );
+		interval_expected += ( ( d * 24 + h ) * 60 + m ) * 60'000;
+	}
+	daw::bench_n_test_mbs<10>(
+	  "parse_iso8601_durations", durations_size,
+	  [duration_expected]( long long r ) { return r == duration_expected; },
+	  []( std::vector<std::string> const &strs ) {
+		  std::vector<std::chrono::milliseconds> values( strs.size( ) );
+		  daw::date_parsing::parse_iso8601_durations( strs.begin( ), strs.end( ),
+		                                              values.begin( ) );
+		  long long result = 0;
+		  for( auto const &v : values ) {
+			  result += v.count( );
+		  }
+		  return result;
+	  },
+	  durations );
+	daw::bench_n_test_mbs<10>(
+	  "parse_iso8601_interval", intervals_size,
+	  [interval_expected]( long long r ) { return r == interval_expected; },
+	  []( std::vector<std::string> const &strs ) {
+		  long long result = 0;
+		  for( auto const &str : strs ) {
+			  result += daw::date_parsing::parse_iso8601_interval(
+			              daw::string_view( str.data( ), str.size( ) ) )
+			              .duration( )
+			              .count( );
+		  }
+		  return result;
+	  },
+	  intervals );
+	daw::bench_n_test_mbs<10>(
+	  "parse_iso8601_timestamp interval starts", intervals_size,
+	  []( long long ) { return true; },
+	  []( std::vector<std::string> const &strs ) {
+		  long long result = 0;
+		  for( auto const &str : strs ) {
+			  result += daw::date_parsing::parse_iso8601_timestamp(
+			              daw::string_view( str.data( ), str.size( ) ) )
+			              .time_since_epoch( )
+			              .count( );
+		  }
+		  return result;
+	  },
+	  interval_starts );
+
+	// The same timestamps straight to int64 epoch units, one at a time and as a
+	// batch, against counting the time_points above
+	long long starts_expected = 0;
+	for( auto const &str : interval_starts ) {
+		starts_expected += daw::date_parsing::parse_iso8601_timestamp( str )
+		                     .time_since_epoch( )
+		                     .count( );
+	}
+	auto const starts_ok = [starts_expected]( long long r ) {
+		return r == starts_expected;
+	};
+	daw::bench_n_test_mbs<10>(
+	  "parse_iso8601_timestamp_to_epoch", intervals_size, starts_ok,
+	  []( std::vector<std::string> const &strs ) {
+		  long long result = 0;
+		  for( auto const &str : strs ) {
+			  result += daw::date_parsing::parse_iso8601_timestamp_to_epoch( str );
+		  }
+		  return result;
+	  },
+	  interval_starts );
+	daw::bench_n_test_mbs<10>(
+	  "parse_iso8601_timestamps_to_epoch", intervals_size, starts_ok,
+	  []( std::vector<std::string> const &strs ) {
+		  std::vector<std::int64_t> values( strs.size( ) );
+		  daw::date_parsing::parse_iso8601_timestamps_to_epoch(
+		    strs.begin( ), strs.end( ), values.data( ) );
+		  long long result = 0;
+		  for( auto const v : values ) {
+			  result += v;
+		  }
+		  return result;
+	  },
+	  interval_starts );
+	daw::bench_n_test_mbs<10>(
+	  "parse_javascript_timestamp", intervals_size, starts_ok,
+	  []( std::vector<std::string> const &strs ) {
+		  long long result = 0;
+		  for( auto const &str : strs ) {
+			  result += daw::date_parsing::parse_javascript_timestamp( str )
+			              .time_since_epoch( )
+			              .count( );
+		  }
+		  return result;
+	  },
+	  interval_starts );
+	daw::bench_n_test_mbs<10>(
+	  "parse_javascript_timestamps_to_epoch", intervals_size, starts_ok,
+	  []( std::vector<std::string> const &strs ) {
+		  std::vector<std::int64_t> values( strs.size( ) );
+		  daw::date_parsing::parse_javascript_timestamps_to_epoch(
+		    strs.begin( ), strs.end( ), values.data( ) );
+		  long long result = 0;
+		  for( auto const v : values ) {
+			  result += v;
+		  }
+		  return result;
+	  },
+	  interval_starts );
+
+	// Newline separated text through a callback, and through the coroutine
+	// generator suspending once per batch and once per timestamp
+	std::string starts_text{ };
+	for( auto const &str : interval_starts ) {
+		starts_text += str;
+		starts_text += '\n';
+	}
+	daw::bench_n_test_mbs<10>(
+	  "incremental_timestamp_parser", starts_text.size( ), starts_ok,
+	  []( std::string const &text ) {
+		  long long result = 0;
+		  auto parser = daw::date_parsing::incremental_timestamp_parser<>( );
+		  parser.feed( daw::string_view( text.data( ), text.size( ) ), [&]( auto tp ) {
+			  result += tp.time_since_epoch( ).count( );
+		  } );
+		  return result;
+	  },
+	  starts_text );
+#if defined( __cpp_impl_coroutine ) and __has_include( <coroutine> )
+	auto const bench_generator = []( std::size_t const batch_size ) {
+		return [batch_size]( std::string const &text ) {
+			long long result = 0;
+			for( auto const &ts : daw::date_parsing::iso8601_lines_generator(
+			       daw::string_view( text.data( ), text.size( ) ), batch_size ) ) {
+				result += ts.time_point.time_since_epoch( ).count( );
+			}
+			return result;
+		};
+	};
+	daw::bench_n_test_mbs<10>( "iso8601_lines_generator", starts_text.size( ),
+	                           starts_ok, bench_generator( 256 ), starts_text );
+	daw::bench_n_test_mbs<10>( "iso8601_lines_generator batch of 1",
+	                           starts_text.size( ), starts_ok, bench_generator( 1 ),
+	                           starts_text );
+#endif
+
+	// Fixed size binary records with the timestamp at a known offset
+	constexpr std::size_t record_stride = 96;
+	constexpr std::size_t record_field_offset = 40;
+	std::vector<char> records( record_stride * interval_starts.size( ), '\0' );
+	for( std::size_t n = 0; n < interval_starts.size( ); ++n ) {
+		std::memcpy( records.data( ) + n * record_stride + record_field_offset,
+		             interval_starts[n].data( ), interval_starts[n].size( ) );
+	}
+	auto const records_size =
+	  interval_starts.size( ) * daw::date_parsing::javascript_timestamp_size;
+	daw::bench_n_test_mbs<10>(
+	  "parse_javascript_timestamp per record", records_size, starts_ok,
+	  []( std::vector<char> const &buff ) {
+		  long long result = 0;
+		  for( std::size_t pos = 0; pos < buff.size( ); pos += record_stride ) {
+			  result += daw::date_parsing::parse_javascript_timestamp(
+			              daw::string_view(
+			                buff.data( ) + pos + record_field_offset,
+			                daw::date_parsing::javascript_timestamp_size ) )
+			              .time_since_epoch( )
+			              .count( );
+		  }
+		  return result;
+	  },
+	  records );
+	auto const bench_strided = []( auto validate, auto prefetch_distance ) {
+		return []( std::vector<char> const &buff ) {
+			auto const count = buff.size( ) / record_stride;
+			std::vector<std::int64_t> values( count );
+			daw::date_parsing::parse_javascript_timestamps_strided<
+			  std::chrono::milliseconds, decltype( validate )::value,
+			  decltype( prefetch_distance )::value>(
+			  buff.data( ), record_stride, record_field_offset, count,
+			  values.data( ) );
+			long long result = 0;
+			for( auto const v : values ) {
+				result += v;
+			}
+			return result;
+		};
+	};
+	daw::bench_n_test_mbs<10>(
+	  "parse_javascript_timestamps_strided", records_size, starts_ok,
+	  bench_strided( std::true_type{ },
+	                 std::integral_constant<std::size_t, 16>{ } ),
+	  records );
+	daw::bench_n_test_mbs<10>(
+	  "parse_javascript_timestamps_strided no prefetch", records_size,
+	  starts_ok,
+	  bench_strided( std::true_type{ }, std::integral_constant<std::size_t, 0>{ } ),
+	  records );
+	daw::bench_n_test_mbs<10>(
+	  "parse_javascript_timestamps_strided unvalidated", records_size,
+	  starts_ok,
+	  bench_strided( std::false_type{ },
+	                 std::integral_constant<std::size_t, 16>{ } ),
+	  records );
+
+	// Heap allocated timestamps visited in an order unrelated to their
+	// addresses, as in a hash join, and too many to stay in cache
+	std::vector<std::string> scattered{ };
+	std::size_t scattered_size = 0;
+	long long scattered_expected = 0;
+	for( std::size_t n = 0; n < 1'000'000; ++n ) {
+		auto const tp = std::chrono::time_point<std::chrono::system_clock,
+		                                        std::chrono::milliseconds>(
+		  std::chrono::milliseconds( 1'483'362'855'000 +
+		                             static_cast<long long>( n ) * 37'001 ) );
+		scattered.push_back( daw::date_formatting::fmt_javascript_timestamp( tp ) );
+		scattered.back( ).reserve( 64 );
+		scattered_size += scattered.back( ).size( );
+		scattered_expected += tp.time_since_epoch( ).count( );
+	}
+	std::shuffle( scattered.begin( ), scattered.end( ), std::mt19937_64{ 1 } );
+	auto const scattered_ok = [scattered_expected]( long long r ) {
+		return r == scattered_expected;
+	};
+	daw::bench_n_test_mbs<10>(
+	  "parse_iso8601_timestamp_to_epoch scattered", scattered_size,
+	  scattered_ok,
+	  []( std::vector<std::string> const &strs ) {
+		  std::vector<std::int64_t> values( strs.size( ) );
+		  for( std::size_t n = 0; n < strs.size( ); ++n ) {
+			  values[n] = daw::date_parsing::parse_iso8601_timestamp_to_epoch( strs[n] );
+		  }
+		  long long result = 0;
+		  for( auto const v : values ) {
+			  result += v;
+		  }
+		  return result;
+	  },
+	  scattered );
+	daw::bench_n_test_mbs<10>(
+	  "parse_iso8601_timestamps_scattered", scattered_size, scattered_ok,
+	  []( std::vector<std::string> const &strs ) {
+		  std::vector<std::int64_t> values( strs.size( ) );
+		  daw::date_parsing::parse_iso8601_timestamps_scattered( strs,
+		                                                         values.data( ) );
+		  long long result = 0;
+		  for( auto const v : values ) {
+			  result += v;
+		  }
+		  return result;
+	  },
+	  scattered );
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_date_formatting.h"
+#include "daw/iso8601/daw_log_index.h"
+
+using ms_tp =
+  std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+std::string make_log( std::size_t const count, std::vector<ms_tp> &times ) {
+	std::string result{ };
+	auto tp = daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T13:14:15Z" );
+	std::uint32_t seed = 7;
+	for( std::size_t n = 0; n < count; ++n ) {
+		seed = seed * 1664525U + 1013904223U;
+		tp += std::chrono::milliseconds( ( seed >> 8U ) % 3000U );
+		times.push_back( tp );
+		daw::date_formatting::fmt_javascript_timestamp(
+		  tp, std::back_inserter( result ) );
+		result += " host=a level=info ";
+		result.append( ( seed >> 16U ) % 100U, 'x' );
+		result += '\n';
+		if( seed % 11U == 0 ) {
+			result += "  continuation\n";
+		}
+	}
+	return result;
+}
+
+bool same_entries( daw::date_parsing::time_index const &lhs,
+                   daw::date_parsing::time_index const &rhs ) {
+	auto const &l = lhs.entries( );
+	auto const &r = rhs.entries( );
+	if( l.size( ) != r.size( ) ) {
+		return false;
+	}
+	for( std::size_t n = 0; n < l.size( ); ++n ) {
+		if( l[n].offset != r[n].offset or l[n].ms != r[n].ms ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main( ) {
+	std::vector<ms_tp> times{ };
+	auto const log = make_log( 50'000, times );
+	auto const options = daw::date_parsing::time_index_options{ 100, 4096 };
+
+	auto full = daw::date_parsing::time_index( options );
+	full.extend( log );
+	daw::expecting( full.indexed_size( ), log.size( ) );
+	daw::expecting( full.entries( ).size( ) > log.size( ) / 8192U, true );
+	auto const data = full.serialize( );
+	daw::expecting( data.size( ) < full.entries( ).size( ) * 8U, true );
+	auto const sv = daw::string_view( data.data( ), data.size( ) );
+	auto const view = daw::date_parsing::time_index_view( sv );
+	daw::expecting( view.size( ), full.entries( ).size( ) );
+
+	for( std::size_t n = 0; n < times.size( ); n += 97 ) {
+		auto const begin = times[n] + std::chrono::microseconds( n % 3 );
+		auto const end = times[( n * 13 ) % times.size( )] +
+		                 std::chrono::microseconds( 500 * ( n % 4 ) );
+		auto const expected = daw::date_parsing::find_time_range( log, begin, end );
+		auto const actual =
+		  daw::date_parsing::find_time_range( view, log, begin, end );
+		daw::expecting( actual.first, expected.first );
+		daw::expecting( actual.last, expected.last );
+		auto const span = view.narrow( begin, end, log.size( ) );
+		daw::expecting( span.size( ) < log.size( ) / 4U or begin >= end or
+		                  expected.size( ) > log.size( ) / 8U,
+		                true );
+	}
+
+	// Extending from a log that was cut mid line matches indexing it whole
+	auto const cut = log.size( ) / 3U + 5U;
+	auto partial = daw::date_parsing::time_index( options );
+	partial.extend( daw::string_view( log.data( ), cut ) );
+	daw::expecting( partial.indexed_size( ) <= cut, true );
+	auto const partial_data = partial.serialize( );
+	auto reloaded = daw::date_parsing::time_index(
+	  daw::string_view( partial_data.data( ), partial_data.size( ) ) );
+	daw::expecting( same_entries( reloaded, partial ), true );
+	reloaded.extend( log );
+	daw::expecting( same_entries( reloaded, full ), true );
+	daw::expecting( reloaded.serialize( ) == data, true );
+
+	bool threw = false;
+	try {
+		auto const bad = std::string( 64, 'x' );
+		(void)daw::date_parsing::time_index_view( bad );
+	} catch( daw::date_parsing::invalid_time_index const & ) { threw = true; }
+	daw::expecting( threw, true );
+
+	std::cout << "log index tests passed\n";
+	return EXIT_SUCCESS;
+}
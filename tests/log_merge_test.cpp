@@ -0,0 +1,105 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_date_formatting.h"
+#include "daw/iso8601/daw_log_merge.h"
+
+int main( ) {
+	// Mixed offsets and layouts, continuation lines and a preamble
+	std::vector<std::string> const inputs{
+	  "2017-01-02T13:14:15Z a1\n"
+	  "2017-01-02T13:14:17.5Z a2\n"
+	  "\tat a2 continuation\n"
+	  "2017-01-02T13:14:20Z a3",
+	  "preamble\n"
+	  "2017-01-02T08:44:16-0430 b1\n"
+	  "2017-01-02T15:14:17.25+0200 b2\n"
+	  "20170102T131419Z b3\n",
+	  "",
+	  "2017-01-02 13:14:15Z c1\n"
+	  "2017-01-02T13:14:17.5Z c2\n" };
+
+	std::vector<std::string> merged{ };
+	std::vector<char const *> pointers{ };
+	daw::date_parsing::merge_sorted_logs( inputs, [&]( daw::string_view rec ) {
+		merged.emplace_back( rec.data( ), rec.size( ) );
+		pointers.push_back( rec.data( ) );
+	} );
+	std::vector<std::string> const expected{
+	  "preamble\n",
+	  "2017-01-02T13:14:15Z a1\n",
+	  "2017-01-02 13:14:15Z c1\n",
+	  "2017-01-02T08:44:16-0430 b1\n",
+	  "2017-01-02T15:14:17.25+0200 b2\n",
+	  "2017-01-02T13:14:17.5Z a2\n\tat a2 continuation\n",
+	  "2017-01-02T13:14:17.5Z c2\n",
+	  "20170102T131419Z b3\n",
+	  "2017-01-02T13:14:20Z a3" };
+	daw::expecting( merged.size( ), expected.size( ) );
+	for( std::size_t n = 0; n < expected.size( ); ++n ) {
+		daw::expecting( merged[n], expected[n] );
+	}
+	// Records are views into the inputs
+	daw::expecting( pointers[1], inputs[0].data( ) );
+
+	// Many inputs compared with a sort of all records
+	std::vector<std::string> logs( 37 );
+	std::vector<std::pair<std::int64_t, std::string>> all{ };
+	std::uint32_t seed = 1;
+	for( std::size_t n = 0; n < logs.size( ); ++n ) {
+		std::int64_t t = 1'483'362'855'000;
+		for( std::size_t line = 0; line < 200U + n; ++line ) {
+			seed = seed * 1664525U + 1013904223U;
+			t += ( seed >> 8U ) % 2000U;
+			auto const tp = std::chrono::time_point<std::chrono::system_clock,
+			                                        std::chrono::milliseconds>(
+			  std::chrono::milliseconds( t ) );
+			auto rec = std::string( );
+			daw::date_formatting::fmt_javascript_timestamp( tp,
+			                                                std::back_inserter( rec ) );
+			rec += " host" + std::to_string( n ) + '\n';
+			logs[n] += rec;
+			all.emplace_back( t, rec );
+		}
+	}
+	std::stable_sort( all.begin( ), all.end( ), []( auto const &l, auto const &r ) {
+		return l.first < r.first;
+	} );
+	std::size_t pos = 0;
+	daw::date_parsing::merge_sorted_logs( logs, [&]( daw::string_view rec ) {
+		daw::expecting( std::string( rec.data( ), rec.size( ) ), all[pos++].second );
+	} );
+	daw::expecting( pos, all.size( ) );
+	std::cout << "log merge tests passed\n";
+	return EXIT_SUCCESS;
+}
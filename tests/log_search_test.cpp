@@ -0,0 +1,117 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_date_formatting.h"
+#include "daw/iso8601/daw_log_search.h"
+
+using ms_tp =
+  std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+struct test_log {
+	std::string data{ };
+	std::vector<std::size_t> line_starts{ };
+	std::vector<ms_tp> times{ };
+};
+
+// A log sorted by time with repeated timestamps, continuation lines and
+// varying line lengths
+test_log make_log( std::size_t const count ) {
+	test_log result{ };
+	auto tp = daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T13:14:15Z" );
+	std::uint32_t seed = 42;
+	for( std::size_t n = 0; n < count; ++n ) {
+		seed = seed * 1664525U + 1013904223U;
+		tp += std::chrono::milliseconds( ( seed >> 8U ) % 5000U );
+		result.line_starts.push_back( result.data.size( ) );
+		result.times.push_back( tp );
+		daw::date_formatting::fmt_javascript_timestamp(
+		  tp, std::back_inserter( result.data ) );
+		result.data += " INFO message ";
+		result.data.append( ( seed >> 16U ) % 40U, 'x' );
+		result.data += '\n';
+		if( seed % 7U == 0 ) {
+			result.data += "\tat continuation line\n";
+		}
+	}
+	return result;
+}
+
+std::size_t linear_lower_bound( test_log const &log, ms_tp const key ) {
+	for( std::size_t n = 0; n < log.times.size( ); ++n ) {
+		if( log.times[n] >= key ) {
+			return log.line_starts[n];
+		}
+	}
+	return log.data.size( );
+}
+
+int main( ) {
+	auto const log = make_log( 10'000 );
+	auto const &times = log.times;
+	for( std::size_t n = 0; n < times.size( ); n += 37 ) {
+		auto const begin = times[n] - std::chrono::milliseconds( n % 3 );
+		auto const end = times[( n * 7 ) % times.size( )] +
+		                 std::chrono::milliseconds( n % 2 );
+		auto const range = daw::date_parsing::find_time_range( log.data, begin, end );
+		daw::expecting( range.first, linear_lower_bound( log, begin ) );
+		if( begin < end ) {
+			daw::expecting( range.last, linear_lower_bound( log, end ) );
+		} else {
+			daw::expecting( range.empty( ), true );
+		}
+	}
+	auto const all = daw::date_parsing::find_time_range(
+	  log.data, times.front( ), times.back( ) + std::chrono::seconds( 1 ) );
+	daw::expecting( all.first, 0U );
+	daw::expecting( all.last, log.data.size( ) );
+
+	auto const none = daw::date_parsing::find_time_range(
+	  log.data, times.back( ) + std::chrono::seconds( 1 ),
+	  times.back( ) + std::chrono::seconds( 2 ) );
+	daw::expecting( none.first, log.data.size( ) );
+	daw::expecting( none.empty( ), true );
+
+	// Mixed offsets are compared in UTC
+	std::string const mixed =
+	  "2017-01-02T13:14:15+0200 a\n"
+	  "2017-01-02T11:14:16Z b\n"
+	  "2017-01-02 06:44:17-0430 c\n"
+	  "2017-01-02T11:14:18.5Z d\n";
+	auto const r = daw::date_parsing::find_time_range(
+	  mixed, daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T11:14:16Z" ),
+	  daw::date_parsing::parse_iso8601_timestamp( "2017-01-02T11:14:18Z" ) );
+	daw::expecting( std::string( mixed.data( ) + r.first, r.size( ) ),
+	                std::string( "2017-01-02T11:14:16Z b\n"
+	                             "2017-01-02 06:44:17-0430 c\n" ) );
+	std::cout << "log search tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_log_timestamp_parsing.h"
+
+int main( ) {
+	using daw::date_parsing::parse_clf_timestamp;
+	using daw::date_parsing::parse_iso8601_timestamp;
+	using daw::date_parsing::parse_syslog_timestamp;
+
+	static_assert( parse_syslog_timestamp( "Oct 16 12:34:56", 2017 ) ==
+	               parse_iso8601_timestamp( "2017-10-16T12:34:56Z" ) );
+	static_assert( parse_syslog_timestamp( "Feb  9 01:02:03", 2016 ) ==
+	               parse_iso8601_timestamp( "2016-02-09T01:02:03Z" ) );
+	static_assert( parse_clf_timestamp( "[10/Oct/2000:13:55:36 -0700]" ) ==
+	               parse_iso8601_timestamp( "2000-10-10T13:55:36-0700" ) );
+	static_assert( parse_clf_timestamp( "01/jan/2018:00:00:00 +0130" ) ==
+	               parse_iso8601_timestamp( "2018-01-01T00:00:00+01:30" ) );
+
+	// Arrays stop at their first nul
+	char syslog_padded[32] = "Oct 16 12:34:56";
+	daw::expecting( parse_syslog_timestamp( syslog_padded, 2017 ) ==
+	                parse_iso8601_timestamp( "2017-10-16T12:34:56Z" ) );
+	char clf_padded[40] = "[10/Oct/2000:13:55:36 -0700]";
+	daw::expecting( parse_clf_timestamp( clf_padded ) ==
+	                parse_iso8601_timestamp( "2000-10-10T13:55:36-0700" ) );
+
+	char const *const months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+	                               "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+	for( int n = 0; n < 12; ++n ) {
+		auto const syslog = std::string( months[n] ) + " 28 23:59:59";
+		auto const iso = std::string( "2019-" ) +
+		                 static_cast<char>( '0' + ( n + 1 ) / 10 ) +
+		                 static_cast<char>( '0' + ( n + 1 ) % 10 ) + "-28T23:59:59Z";
+		daw::expecting(
+		  parse_syslog_timestamp( daw::string_view( syslog.data( ), syslog.size( ) ),
+		                          2019 ) ==
+		  parse_iso8601_timestamp( daw::string_view( iso.data( ), iso.size( ) ) ) );
+	}
+	for( auto const &month : { "JUN", "jUn", "jun" } ) {
+		daw::expecting( daw::date_parsing::details::parse_month_name( month ), 6U );
+	}
+
+	auto const throws = []( auto f ) {
+		try {
+			(void)f( );
+		} catch( invalid_syslog_timestamp const & ) {
+			return true;
+		} catch( invalid_clf_timestamp const & ) {
+			return true;
+		}
+		return false;
+	};
+	daw::expecting( throws( [] {
+		return parse_syslog_timestamp( "Oct 16 12:34", 2017 );
+	} ) );
+	daw::expecting( throws( [] {
+		return parse_syslog_timestamp( "Ocu 16 12:34:56", 2017 );
+	} ) );
+	daw::expecting( throws( [] {
+		return parse_syslog_timestamp( "Feb 29 12:34:56", 2017 );
+	} ) );
+	daw::expecting( throws( [] {
+		return parse_clf_timestamp( "[10/Oct/2000:13:55:36 -0700" );
+	} ) );
+	daw::expecting( throws( [] {
+		return parse_clf_timestamp( "10/Xyz/2000:13:55:36 -0700" );
+	} ) );
+
+	std::cout << "log timestamp parsing tests passed\n";
+	return EXIT_SUCCESS;
+}
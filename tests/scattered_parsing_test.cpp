@@ -0,0 +1,83 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_string_view.h>
+
+#include "daw/iso8601/daw_scattered_parsing.h"
+
+int main( ) {
+	using namespace std::chrono;
+	std::vector<std::string> timestamps{ };
+	std::vector<std::int64_t> expected{ };
+	for( std::size_t n = 0; n < 103; ++n ) {
+		if( n % 17 == 5 ) {
+			timestamps.push_back( "2018-02-30T01:02:03Z" );
+			expected.push_back( 0 );
+			continue;
+		}
+		auto const ts = "2018-01-" + std::to_string( 10 + n % 20 ) + "T01:02:0" +
+		                std::to_string( n % 10 ) + "." + std::to_string( n % 1000 ) +
+		                "+01:00";
+		timestamps.push_back( ts );
+		expected.push_back(
+		  daw::date_parsing::parse_iso8601_timestamp_to_epoch<microseconds>( ts ) );
+	}
+	std::vector<std::int64_t> values( timestamps.size( ) );
+	daw::expecting(
+	  daw::date_parsing::parse_iso8601_timestamps_scattered<microseconds>(
+	    timestamps, values.data( ) ) == 6U );
+	daw::expecting( values == expected );
+
+	// No prefetch and groups of one give the same result
+	std::fill( values.begin( ), values.end( ), -1 );
+	daw::expecting(
+	  daw::date_parsing::parse_iso8601_timestamps_scattered<microseconds, 0, 1>(
+	    timestamps.data( ), timestamps.size( ), values.data( ) ) == 6U );
+	daw::expecting( values == expected );
+
+	// Pointer and length pairs
+	std::vector<daw::string_view> views{ };
+	for( auto const &ts : timestamps ) {
+		views.emplace_back( ts.data( ), ts.size( ) );
+	}
+	std::fill( values.begin( ), values.end( ), -1 );
+	daw::expecting(
+	  daw::date_parsing::parse_iso8601_timestamps_scattered<microseconds, 4, 8>(
+	    views.data( ), 9, values.data( ) ) == 1U );
+	for( std::size_t n = 0; n < 9; ++n ) {
+		daw::expecting( values[n] == expected[n] );
+	}
+	daw::expecting( values[9] == -1 );
+
+	std::cout << "scattered parsing tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <iterator>
+#include <stdexcept>
 
 #include <daw/daw_string_view.h>
 
@@ -112,6 +113,12 @@ int main( ) {
 
 	daw::date_formatting::fmt_stream( "%C %D\n", tp01, std::cout );
 
+	std::cout << "fixed layout javascript formatter\n";
+	auto const js_str = daw::date_formatting::fmt_javascript_timestamp( tp01 );
+	std::cout << js_str << '\n';
+	daw::exception::precondition_check<std::runtime_error>(
+	  js_str == "2016-12-31T01:02:03.343Z", "Unexpected javascript timestamp" );
+
 	std::cout << "constexpr fmt object\n";
 	auto df2 =
 	  daw::date_formatting::date_formatter_t<char>( "{0}T{1}:{2}:{3}\n" );
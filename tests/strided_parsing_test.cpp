@@ -0,0 +1,111 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_date_formatting.h"
+#include "daw/iso8601/daw_strided_parsing.h"
+
+template<bool Validate = true>
+constexpr std::int64_t swar_epoch( char const *str ) {
+	daw::date_parsing::details::timestamp_fields fields{ };
+	if( not daw::date_parsing::details::try_parse_javascript_swar<Validate>(
+	      str, fields ) ) {
+		return -1;
+	}
+	return daw::date_parsing::details::to_epoch<std::chrono::milliseconds>(
+	  fields );
+}
+
+int main( ) {
+	using namespace std::chrono;
+	static_assert( swar_epoch( "2018-01-02T01:02:03.343Z" ) == 1'514'854'923'343 );
+	static_assert( swar_epoch( "2018-01-02t01:02:03.343z" ) == 1'514'854'923'343 );
+	static_assert( swar_epoch( "1969-12-31T23:59:59.999Z" ) == -1'000 + 999 );
+	static_assert( swar_epoch( "2016-02-29T00:00:00.000Z" ) ==
+	               daw::date_parsing::parse_javascript_timestamp_to_epoch(
+	                 "2016-02-29T00:00:00.000Z" ) );
+	static_assert( swar_epoch( "2018-13-02T01:02:03.343Z" ) == -1 );
+	static_assert( swar_epoch( "2017-02-29T01:02:03.343Z" ) == -1 );
+	static_assert( swar_epoch( "2018-01-02T24:02:03.343Z" ) == -1 );
+	static_assert( swar_epoch( "2018-01-02 01:02:03.343Z" ) == -1 );
+	static_assert( swar_epoch( "2018-01-02T01:02:03,343Z" ) == -1 );
+	static_assert( swar_epoch( "2018-01-02T01:02:03.343+" ) == -1 );
+	static_assert( swar_epoch<false>( "2018-01-02T01:02:03.343Z" ) ==
+	               1'514'854'923'343 );
+
+	// Records of an 8 byte header, the timestamp and 16 bytes of payload
+	constexpr std::size_t stride = 48;
+	constexpr std::size_t field_offset = 8;
+	constexpr std::size_t count = 1'000;
+	std::vector<char> records( stride * count, '\x7F' );
+	std::vector<std::int64_t> expected( count );
+	for( std::size_t n = 0; n < count; ++n ) {
+		auto const tp = time_point<system_clock, milliseconds>(
+		  milliseconds( 1'483'362'855'123 + static_cast<std::int64_t>( n ) *
+		                                      86'399'937 ) );
+		auto const str = daw::date_formatting::fmt_javascript_timestamp( tp );
+		std::memcpy( records.data( ) + n * stride + field_offset, str.data( ),
+		             str.size( ) );
+		expected[n] = tp.time_since_epoch( ).count( );
+	}
+	// Every digit and separator position rejects a bad character
+	for( std::size_t pos = 0; pos < daw::date_parsing::javascript_timestamp_size;
+	     ++pos ) {
+		records[( pos + 1 ) * stride + field_offset + pos] = '/';
+		expected[pos + 1] = 0;
+	}
+	std::vector<std::int64_t> values( count );
+	auto const invalid_count =
+	  daw::date_parsing::parse_javascript_timestamps_strided(
+	    records.data( ), stride, field_offset, count, values.data( ) );
+	daw::expecting( invalid_count ==
+	                daw::date_parsing::javascript_timestamp_size );
+	daw::expecting( values == expected );
+
+	std::vector<std::int64_t> us_values( count );
+	daw::date_parsing::parse_javascript_timestamps_strided<microseconds, true, 0>(
+	  records.data( ), stride, field_offset, 1, us_values.data( ) );
+	daw::expecting( us_values[0] == expected[0] * 1'000 );
+
+	// Unvalidated, the records without a bad character still match
+	daw::expecting( daw::date_parsing::parse_javascript_timestamps_strided<
+	                  milliseconds, false>( records.data( ), stride, field_offset,
+	                                        count, values.data( ) ) == 0U );
+	for( std::size_t n = daw::date_parsing::javascript_timestamp_size + 1;
+	     n < count; ++n ) {
+		daw::expecting( values[n] == expected[n] );
+	}
+
+	std::cout << "strided parsing tests passed\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,221 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_timestamp_generator.h"
+
+#if defined( __cpp_impl_coroutine ) and __has_include( <coroutine> )
+namespace {
+	using tp_t =
+	  std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
+	// A minimal event loop.  Reads suspend and are completed by run
+	struct event_loop {
+		std::vector<std::coroutine_handle<>> ready{ };
+
+		void run( ) {
+			while( not ready.empty( ) ) {
+				auto const handle = ready.back( );
+				ready.pop_back( );
+				handle.resume( );
+			}
+		}
+	};
+
+	struct chunk_source {
+		event_loop *loop;
+		std::string const *text;
+		std::size_t chunk_size;
+		std::size_t position = 0;
+		std::size_t read_count = 0;
+
+		struct read_awaiter {
+			chunk_source *source;
+
+			bool await_ready( ) const noexcept {
+				return false;
+			}
+
+			void await_suspend( std::coroutine_handle<> handle ) {
+				source->loop->ready.push_back( handle );
+			}
+
+			daw::string_view await_resume( ) noexcept {
+				auto &s = *source;
+				++s.read_count;
+				auto const size = s.text->size( ) - s.position < s.chunk_size
+				                    ? s.text->size( ) - s.position
+				                    : s.chunk_size;
+				auto const result = daw::string_view( s.text->data( ) + s.position, size );
+				s.position += size;
+				return result;
+			}
+		};
+
+		read_awaiter operator( )( ) noexcept {
+			return read_awaiter{ this };
+		}
+	};
+
+	struct task {
+		struct promise_type {
+			task get_return_object( ) noexcept {
+				return { };
+			}
+			std::suspend_never initial_suspend( ) const noexcept {
+				return { };
+			}
+			std::suspend_never final_suspend( ) const noexcept {
+				return { };
+			}
+			void return_void( ) noexcept {}
+			void unhandled_exception( ) noexcept {
+				std::abort( );
+			}
+		};
+	};
+
+	task consume( daw::date_parsing::async_batch_generator<tp_t> generator,
+	              std::vector<tp_t> &result, std::size_t &batch_count,
+	              bool &finished ) {
+		for( auto batch = co_await generator.next_batch( ); not batch.empty( );
+		     batch = co_await generator.next_batch( ) ) {
+			result.insert( result.end( ), batch.begin( ), batch.end( ) );
+			++batch_count;
+		}
+		finished = true;
+	}
+
+	struct string_reader {
+		std::string const *text;
+		std::size_t chunk_size;
+		std::size_t position = 0;
+
+		daw::string_view next( ) {
+			auto const size = text->size( ) - position < chunk_size
+			                    ? text->size( ) - position
+			                    : chunk_size;
+			auto const result = daw::string_view( text->data( ) + position, size );
+			position += size;
+			return result;
+		}
+	};
+} // namespace
+
+int main( ) {
+	std::vector<std::string> const samples{ "2017-01-02T13:14:15-0430",
+	                                        "2018-01-02T01:02:03.343Z\r",
+	                                        "",
+	                                        "20180102T010203.343+0000",
+	                                        "not a timestamp" };
+	std::string text{ };
+	std::vector<tp_t> expected{ };
+	std::vector<std::size_t> offsets{ };
+	for( std::size_t n = 0; n < 1000; ++n ) {
+		auto line = samples[n % samples.size( )];
+		auto const offset = text.size( );
+		text += line;
+		text += '\n';
+		if( not line.empty( ) and line.back( ) == '\r' ) {
+			line.pop_back( );
+		}
+		if( line.empty( ) or line == samples.back( ) ) {
+			continue;
+		}
+		expected.push_back( daw::date_parsing::parse_iso8601_timestamp( line ) );
+		offsets.push_back( offset );
+	}
+	text.pop_back( );
+
+	// Buffer, item by item and batch by batch
+	{
+		std::size_t n = 0;
+		for( auto const &ts :
+		     daw::date_parsing::iso8601_lines_generator( text, 64 ) ) {
+			daw::expecting( ts.offset, offsets[n] );
+			daw::expecting( ts.time_point == expected[n], true );
+			++n;
+		}
+		daw::expecting( n, expected.size( ) );
+
+		auto generator = daw::date_parsing::iso8601_lines_generator( text, 64 );
+		std::size_t batch_count = 0;
+		n = 0;
+		for( auto batch = generator.next_batch( ); not batch.empty( );
+		     batch = generator.next_batch( ) ) {
+			daw::expecting( batch.size( ) <= 64U, true );
+			n += batch.size( );
+			++batch_count;
+		}
+		daw::expecting( n, expected.size( ) );
+		daw::expecting( batch_count, ( expected.size( ) + 63U ) / 64U );
+		daw::expecting( generator.next_batch( ).empty( ), true );
+		daw::expecting( daw::date_parsing::iso8601_lines_generator( "" ).begin( ) ==
+		                  std::default_sentinel,
+		                true );
+	}
+
+	// Chunked reader
+	for( std::size_t const chunk_size : { 1U, 7U, 100U, 100000U } ) {
+		auto reader = string_reader{ &text, chunk_size };
+		std::vector<tp_t> result{ };
+		for( auto const tp :
+		     daw::date_parsing::iso8601_chunks_generator( reader, 32 ) ) {
+			result.push_back( tp );
+		}
+		daw::expecting( result == expected, true );
+	}
+
+	// Asynchronous source, suspending on each read
+	for( std::size_t const chunk_size : { 1U, 7U, 100U, 100000U } ) {
+		auto loop = event_loop{ };
+		auto source = chunk_source{ &loop, &text, chunk_size };
+		std::vector<tp_t> result{ };
+		std::size_t batch_count = 0;
+		bool finished = false;
+		consume( daw::date_parsing::iso8601_async_generator(
+		           [&source] { return source( ); }, 128 ),
+		         result, batch_count, finished );
+		daw::expecting( finished, false );
+		loop.run( );
+		daw::expecting( finished, true );
+		daw::expecting( result == expected, true );
+		daw::expecting( batch_count < source.read_count, true );
+	}
+
+	std::cout << "timestamp generator tests passed\n";
+	return EXIT_SUCCESS;
+}
+#else
+int main( ) {
+	std::cout << "coroutines are unavailable, timestamp generator tests skipped\n";
+	return EXIT_SUCCESS;
+}
+#endif
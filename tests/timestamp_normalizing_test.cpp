@@ -0,0 +1,92 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_date_formatting.h"
+#include "daw/iso8601/daw_timestamp_normalizing.h"
+
+std::string norm( daw::string_view ts ) {
+	return daw::date_parsing::normalize_iso8601( ts );
+}
+
+int main( ) {
+	daw::expecting( norm( "2017-01-02T13:14:15Z" ), "2017-01-02T13:14:15Z" );
+	daw::expecting( norm( "2017-01-02 13:14:15+00:00" ), "2017-01-02T13:14:15Z" );
+	daw::expecting( norm( "20170102T131415.25" ), "2017-01-02T13:14:15.25Z" );
+	daw::expecting( norm( "2017-01-02T13:14:15-0430" ), "2017-01-02T17:44:15Z" );
+	daw::expecting( norm( "2017-01-02T13:14:15.123456789123+0430" ),
+	                "2017-01-02T08:44:15.123456789Z" );
+	daw::expecting( norm( "2017-01-01T01:14:15+0430" ), "2016-12-31T20:44:15Z" );
+	daw::expecting( norm( "2016-02-29T22:00:00\xE2\x88\x92"
+	                      "02:30" ),
+	                "2016-03-01T00:30:00Z" );
+	daw::expecting( norm( "2017-02-28T22:00:00-0230" ), "2017-03-01T00:30:00Z" );
+	daw::expecting( norm( "2016-12-31T23:59:59-01" ), "2017-01-01T00:59:59Z" );
+	daw::expecting( norm( "2016-03-01T00:59:59+01" ), "2016-02-29T23:59:59Z" );
+
+	char buff[daw::date_parsing::max_normalized_size]{ };
+	daw::expecting( daw::date_parsing::normalize_iso8601( "2017-13-02T13:14:15Z",
+	                                                      buff ),
+	                0U );
+	daw::expecting( daw::date_parsing::normalize_iso8601( "0000-01-01T00:00:00+01",
+	                                                      buff ),
+	                0U );
+
+	// Compare with parse + format over a spread of instants and offsets
+	std::uint32_t seed = 3;
+	for( std::size_t n = 0; n < 100'000; ++n ) {
+		seed = seed * 1664525U + 1013904223U;
+		auto const ms = static_cast<std::int64_t>( seed ) * 73'000'123 % 253'000'000'000'000;
+		auto const tp = std::chrono::time_point<std::chrono::system_clock,
+		                                        std::chrono::milliseconds>(
+		  std::chrono::milliseconds( ms < 0 ? -ms : ms ) );
+		auto const offset_minutes = static_cast<int>( seed >> 20U ) % 1440 - 720;
+		auto local = daw::date_formatting::fmt_javascript_timestamp(
+		  tp + std::chrono::minutes( offset_minutes ) );
+		local.pop_back( );
+		auto const abs_offset = offset_minutes < 0 ? -offset_minutes : offset_minutes;
+		local += offset_minutes < 0 ? '-' : '+';
+		local += static_cast<char>( '0' + abs_offset / 600 );
+		local += static_cast<char>( '0' + abs_offset / 60 % 10 );
+		local += static_cast<char>( '0' + abs_offset % 60 / 10 );
+		local += static_cast<char>( '0' + abs_offset % 10 );
+		daw::expecting( norm( local ),
+		                daw::date_formatting::fmt_javascript_timestamp( tp ) );
+	}
+
+	std::string out{ };
+	auto const count = daw::date_parsing::normalize_iso8601_lines(
+	  "2017-01-02T13:14:15-0430\nbad\n2017-01-02T13:14:15+0430", out );
+	daw::expecting( count, 2U );
+	daw::expecting( out, "2017-01-02T17:44:15Z\nbad\n2017-01-02T08:44:15Z" );
+
+	std::cout << "timestamp normalizing tests passed\n";
+	return EXIT_SUCCESS;
+}
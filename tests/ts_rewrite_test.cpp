@@ -0,0 +1,167 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include <daw/daw_benchmark.h>
+
+#include "daw/iso8601/daw_date_formatting.h"
+
+// ts_rewrite_test <path to ts_rewrite>
+//   Runs the tool on files and on stdin and checks its output
+namespace {
+	std::string tool{ };
+	std::filesystem::path input_path{ };
+	std::filesystem::path output_path{ };
+
+	void write_file( std::filesystem::path const &path, std::string const &text ) {
+		auto out = std::ofstream( path, std::ios::binary | std::ios::trunc );
+		out.write( text.data( ), static_cast<std::streamsize>( text.size( ) ) );
+	}
+
+	std::string read_file( std::filesystem::path const &path ) {
+		auto in = std::ifstream( path, std::ios::binary );
+		return std::string( std::istreambuf_iterator<char>( in ),
+		                    std::istreambuf_iterator<char>( ) );
+	}
+
+	std::string rewrite( std::string const &args, std::string const &input,
+	                     bool const from_stdin = false ) {
+		write_file( input_path, input );
+		auto const command = '"' + tool + "\" " + args +
+		                     ( from_stdin ? " < \"" : " \"" ) +
+		                     input_path.string( ) + "\" > \"" +
+		                     output_path.string( ) + "\" 2> /dev/null";
+		daw::expecting( std::system( command.c_str( ) ), 0 );
+		return read_file( output_path );
+	}
+
+	void check( std::string const &args, std::string const &input,
+	            std::string const &expected ) {
+		for( bool const from_stdin : { false, true } ) {
+			auto const output = rewrite( args, input, from_stdin );
+			if( output != expected ) {
+				std::cerr << "ts_rewrite " << args << ( from_stdin ? " < " : " " )
+				          << "input\n"
+				          << input << "\nexpected\n"
+				          << expected << "\ngot\n"
+				          << output << '\n';
+				std::exit( EXIT_FAILURE );
+			}
+		}
+	}
+} // namespace
+
+int main( int argc, char **argv ) {
+	if( argc < 2 ) {
+		std::cerr << "Usage: ts_rewrite_test <path to ts_rewrite>\n";
+		return EXIT_FAILURE;
+	}
+	tool = argv[1];
+	auto const dir = std::filesystem::temp_directory_path( );
+	input_path = dir / "ts_rewrite_test_input.log";
+	output_path = dir / "ts_rewrite_test_output.log";
+
+	// Field selection by column and by offset
+	check( "", "2017-01-02T13:14:15.123-0430 msg\n",
+	       "2017-01-02T17:44:15.123Z msg\n" );
+	check( "--column 1", "INFO  2017-01-02T13:14:15.123-0430\tmsg\n",
+	       "INFO  2017-01-02T17:44:15.123Z\tmsg\n" );
+	check( "--offset 3", "id=2017-01-02T13:14:15.123-0430 msg\n",
+	       "id=2017-01-02T17:44:15.123Z msg\n" );
+
+	// Every output layout
+	auto const iso = std::string( "2017-01-02T13:14:15.123-0430 x\n" );
+	check( "--to javascript", iso, "2017-01-02T17:44:15.123Z x\n" );
+	check( "--to epoch", iso, "1483379055123 x\n" );
+	check( "--to epoch-s", iso, "1483379055 x\n" );
+	check( "--to epoch-ms", iso, "1483379055123 x\n" );
+	check( "--to epoch-us", iso, "1483379055123000 x\n" );
+	check( "--to epoch-ns", iso, "1483379055123000000 x\n" );
+	check( "--to http", iso, "Mon, 02 Jan 2017 17:44:15 GMT x\n" );
+	check( "--precision 0", iso, "2017-01-02T17:44:15Z x\n" );
+	check( "--precision 6", iso, "2017-01-02T17:44:15.123000Z x\n" );
+	check( "--to epoch-s", "1969-12-31T23:59:59.5Z\n", "-1\n" );
+
+	// Every input layout
+	check( "--from javascript --to epoch-ms", "2017-01-02T17:44:15.123Z\n",
+	       "1483379055123\n" );
+	check( "--from epoch", "1483379055123 x\n", "2017-01-02T17:44:15.123Z x\n" );
+	check( "--from epoch", "1483379055 x\n", "2017-01-02T17:44:15.000Z x\n" );
+	check( "--from epoch-s", "1483379055\n", "2017-01-02T17:44:15.000Z\n" );
+	check( "--from epoch-ms", "1483379055123\n", "2017-01-02T17:44:15.123Z\n" );
+	check( "--from epoch-us", "1483379055123456\n",
+	       "2017-01-02T17:44:15.123Z\n" );
+	check( "--from epoch-ns --precision 9", "1483379055123456789\n",
+	       "2017-01-02T17:44:15.123456789Z\n" );
+	check( "--from http", "Mon, 02 Jan 2017 17:44:15 GMT x\n",
+	       "2017-01-02T17:44:15.000Z x\n" );
+	check( "--from clf --column 3 --to epoch-s",
+	       "127.0.0.1 - - [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0\" 200\n",
+	       "127.0.0.1 - - 971211336 \"GET / HTTP/1.0\" 200\n" );
+	check( "--from syslog --year 2017", "Oct 16 12:34:56 host msg\n",
+	       "2017-10-16T12:34:56.000Z host msg\n" );
+
+	// Lines without a valid timestamp are copied unchanged, and line ends are
+	// kept as they are
+	check( "--column 1",
+	       "no timestamp here\n\nINFO\nINFO 2017-13-02T00:00:00Z\n"
+	       "INFO 2017-01-02T13:14:15.123-0430\r\nINFO 2017-01-02T13:14:15Z",
+	       "no timestamp here\n\nINFO\nINFO 2017-13-02T00:00:00Z\n"
+	       "INFO 2017-01-02T17:44:15.123Z\r\nINFO 2017-01-02T13:14:15Z" );
+	check( "--from clf", "[10/Oct/2000:13:55:36\n", "[10/Oct/2000:13:55:36\n" );
+
+	// Many small chunks over several threads are written in input order
+	std::string input{ };
+	std::string expected{ };
+	auto tp = std::chrono::time_point<std::chrono::system_clock,
+	                                  std::chrono::milliseconds>(
+	  std::chrono::milliseconds( 1483379055123 ) );
+	for( std::size_t n = 0; n < 20'000; ++n ) {
+		tp += std::chrono::milliseconds( n % 977U );
+		auto const count = std::to_string( tp.time_since_epoch( ).count( ) );
+		input += std::to_string( n ) + ' ' + count + " line\n";
+		expected += std::to_string( n ) + ' ' +
+		            daw::date_formatting::fmt_javascript_timestamp( tp ) + " line\n";
+	}
+	check( "--column 1 --from epoch-ms --to javascript --threads 4 "
+	       "--chunk-size 1000",
+	       input, expected );
+
+	// A line longer than a chunk, which grows the stdin buffer
+	auto const long_field = std::string( 5000, 'x' );
+	check( "--column 1 --chunk-size 1000",
+	       long_field + " 2017-01-02T13:14:15.123-0430\nx 2017-01-02T13:14:15Z\n",
+	       long_field + " 2017-01-02T17:44:15.123Z\nx 2017-01-02T13:14:15Z\n" );
+
+	std::filesystem::remove( input_path );
+	std::filesystem::remove( output_path );
+	std::cout << "ts_rewrite tests passed\n";
+	return EXIT_SUCCESS;
+}
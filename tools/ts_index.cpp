@@ -0,0 +1,114 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include <daw/daw_memory_mapped_file.h>
+
+#include "daw/iso8601/daw_date_parsing.h"
+#include "daw/iso8601/daw_log_index.h"
+
+// ts_index build <log> [index] [line stride] [byte stride]
+//   Create the sidecar index of a log, or extend it when the log has grown
+// ts_index query <log> <begin> <end> [index]
+//   Write the lines of the log with a timestamp in [begin, end) to stdout
+namespace {
+	int usage( ) {
+		std::cerr << "Usage:\n"
+		          << "  ts_index build <log> [index] [line stride] [byte stride]\n"
+		          << "  ts_index query <log> <begin> <end> [index]\n";
+		return EXIT_FAILURE;
+	}
+
+	daw::string_view as_sv( daw::filesystem::memory_mapped_file_t<char> const &mmf ) {
+		return daw::string_view( mmf.data( ), mmf.size( ) );
+	}
+
+	int build( std::string const &log_path, std::string const &index_path,
+	           daw::date_parsing::time_index_options const &options ) {
+		daw::filesystem::memory_mapped_file_t<char> log( log_path );
+		if( not log ) {
+			std::cerr << "Could not open " << log_path << '\n';
+			return EXIT_FAILURE;
+		}
+		auto index = daw::date_parsing::time_index( options );
+		if( std::filesystem::exists( index_path ) and
+		    std::filesystem::file_size( index_path ) > 0 ) {
+			daw::filesystem::memory_mapped_file_t<char> existing( index_path );
+			index = daw::date_parsing::time_index( as_sv( existing ) );
+		}
+		auto const before = index.entries( ).size( );
+		index.extend( as_sv( log ) );
+		index.write( index_path );
+		std::cerr << "Indexed " << index.indexed_size( ) << " bytes, "
+		          << index.entries( ).size( ) << " entries ("
+		          << index.entries( ).size( ) - before << " new)\n";
+		return EXIT_SUCCESS;
+	}
+
+	int query( std::string const &log_path, std::string const &index_path,
+	           daw::string_view begin_str, daw::string_view end_str ) {
+		daw::filesystem::memory_mapped_file_t<char> log( log_path );
+		daw::filesystem::memory_mapped_file_t<char> index_file( index_path );
+		if( not log or not index_file ) {
+			std::cerr << "Could not open " << log_path << " or " << index_path
+			          << '\n';
+			return EXIT_FAILURE;
+		}
+		auto const index = daw::date_parsing::time_index_view( as_sv( index_file ) );
+		auto const range = daw::date_parsing::find_time_range(
+		  index, log, daw::date_parsing::parse_iso8601_timestamp( begin_str ),
+		  daw::date_parsing::parse_iso8601_timestamp( end_str ) );
+		std::fwrite( log.data( ) + range.first, 1, range.size( ), stdout );
+		return EXIT_SUCCESS;
+	}
+} // namespace
+
+int main( int argc, char **argv ) {
+	if( argc < 3 ) {
+		return usage( );
+	}
+	auto const command = std::string( argv[1] );
+	auto const log_path = std::string( argv[2] );
+	if( command == "build" ) {
+		auto const index_path = argc > 3 ? std::string( argv[3] ) : log_path + ".tsidx";
+		auto options = daw::date_parsing::time_index_options{ };
+		if( argc > 4 ) {
+			options.line_stride = std::strtoull( argv[4], nullptr, 10 );
+		}
+		if( argc > 5 ) {
+			options.byte_stride = std::strtoull( argv[5], nullptr, 10 );
+		}
+		return build( log_path, index_path, options );
+	}
+	if( command == "query" and argc > 4 ) {
+		auto const index_path = argc > 5 ? std::string( argv[5] ) : log_path + ".tsidx";
+		return query( log_path, index_path, daw::string_view( argv[3] ),
+		              daw::string_view( argv[4] ) );
+	}
+	return usage( );
+}
@@ -0,0 +1,549 @@
+// The MIT License (MIT)
+//
+// Copyright (c) Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <daw/daw_memory_mapped_file.h>
+
+#include "daw/iso8601/daw_date_formatting.h"
+#include "daw/iso8601/daw_date_parsing.h"
+#include "daw/iso8601/daw_epoch_parsing.h"
+#include "daw/iso8601/daw_http_date.h"
+#include "daw/iso8601/daw_log_timestamp_parsing.h"
+#include "daw/iso8601/daw_timestamp_normalizing.h"
+
+// ts_rewrite [options] [file]
+//   Rewrite the timestamp in each line of file, or stdin, to stdout.  Lines
+//   whose timestamp is missing or invalid are copied unchanged.  The input is
+//   split into chunks at line ends which are rewritten in parallel and
+//   written in order
+namespace {
+	using ns_time_t =
+	  std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+
+	enum class layout {
+		iso8601,
+		javascript,
+		epoch,
+		epoch_s,
+		epoch_ms,
+		epoch_us,
+		epoch_ns,
+		http,
+		clf,
+		syslog
+	};
+
+	struct rewrite_options {
+		layout from = layout::iso8601;
+		layout to = layout::iso8601;
+		// Fraction digits of ISO 8601 output, -1 keeps those of ISO 8601 input
+		int precision = -1;
+		std::size_t column = 0;
+		// When set, the timestamp starts at this byte of the line, instead of
+		// being the column'th whitespace separated field
+		std::size_t offset = 0;
+		bool use_offset = false;
+		// The year of syslog timestamps, which have none
+		std::int32_t year = 1970;
+		std::size_t threads = 0;
+		std::size_t chunk_size = 4U * 1024U * 1024U;
+	};
+
+	int usage( ) {
+		std::cerr
+		  << "Usage:\n"
+		  << "  ts_rewrite [options] [file]\n"
+		  << "Options:\n"
+		  << "  --from <layout>     layout of the input timestamps, default iso8601\n"
+		  << "  --to <layout>       layout of the output timestamps, default iso8601\n"
+		  << "  --precision <0-9>   fraction digits of iso8601 output, by default\n"
+		  << "                      those of iso8601 input or else 3\n"
+		  << "  --column <n>        timestamp is the n'th whitespace separated field, "
+		     "default 0\n"
+		  << "  --offset <n>        timestamp starts at byte n of each line\n"
+		  << "  --year <n>          year of syslog timestamps\n"
+		  << "  --threads <n>       worker threads, default all cores\n"
+		  << "  --chunk-size <n>    bytes per unit of work, default 4MiB\n"
+		  << "Layouts:\n"
+		  << "  iso8601 javascript epoch epoch-s epoch-ms epoch-us epoch-ns http "
+		     "clf syslog\n"
+		  << "  iso8601 output is UTC.  epoch input infers its unit from its digit "
+		     "count.\n"
+		  << "  clf and syslog are input only\n";
+		return EXIT_FAILURE;
+	}
+
+	bool parse_layout( daw::string_view name, layout &result ) {
+		struct entry {
+			char const *name;
+			layout value;
+		};
+		static constexpr entry layouts[] = {
+		  { "iso8601", layout::iso8601 },   { "javascript", layout::javascript },
+		  { "epoch", layout::epoch },       { "epoch-s", layout::epoch_s },
+		  { "epoch-ms", layout::epoch_ms }, { "epoch-us", layout::epoch_us },
+		  { "epoch-ns", layout::epoch_ns }, { "http", layout::http },
+		  { "clf", layout::clf },           { "syslog", layout::syslog } };
+		for( auto const &e : layouts ) {
+			if( name == daw::string_view( e.name ) ) {
+				result = e.value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	constexpr bool is_space( char const c ) noexcept {
+		return c == ' ' or c == '\t';
+	}
+
+	// Layouts with spaces have a fixed size, the rest end at whitespace
+	constexpr std::size_t fixed_size( layout const l ) noexcept {
+		switch( l ) {
+		case layout::http:
+			return daw::date_parsing::http_date_size;
+		case layout::clf:
+			return 28;
+		case layout::syslog:
+			return 15;
+		default:
+			return 0;
+		}
+	}
+
+	// The bounds of the timestamp field of line
+	bool find_field( daw::string_view const line, rewrite_options const &opts,
+	                 std::size_t &first, std::size_t &last ) noexcept {
+		auto pos = std::size_t{ 0 };
+		if( opts.use_offset ) {
+			pos = opts.offset;
+		} else {
+			while( pos < line.size( ) and is_space( line[pos] ) ) {
+				++pos;
+			}
+			for( std::size_t c = 0; c < opts.column; ++c ) {
+				while( pos < line.size( ) and not is_space( line[pos] ) ) {
+					++pos;
+				}
+				while( pos < line.size( ) and is_space( line[pos] ) ) {
+					++pos;
+				}
+			}
+		}
+		if( pos >= line.size( ) ) {
+			return false;
+		}
+		first = pos;
+		if( auto const size = fixed_size( opts.from ); size > 0 ) {
+			last = first + size;
+			return last <= line.size( );
+		}
+		while( pos < line.size( ) and not is_space( line[pos] ) ) {
+			++pos;
+		}
+		last = pos;
+		return true;
+	}
+
+	// Nanoseconds since the epoch are used between layouts, which covers the
+	// years 1678 to 2261
+	bool parse_field( daw::string_view const str, rewrite_options const &opts,
+	                  ns_time_t &result ) {
+		namespace dp = daw::date_parsing;
+		using std::chrono::nanoseconds;
+		std::int64_t count = 0;
+		switch( opts.from ) {
+		case layout::iso8601:
+		case layout::javascript: {
+			dp::details::timestamp_fields fields{ };
+			if( not dp::details::try_parse_iso8601_timestamp( str, fields ) or
+			    fields.y < 1678 or fields.y > 2261 ) {
+				return false;
+			}
+			count = dp::details::to_epoch<nanoseconds>( fields );
+			break;
+		}
+		case layout::epoch:
+		case layout::epoch_s:
+		case layout::epoch_ms:
+		case layout::epoch_us:
+		case layout::epoch_ns: {
+			constexpr dp::epoch_unit units[] = {
+			  dp::epoch_unit::detect, dp::epoch_unit::seconds,
+			  dp::epoch_unit::milliseconds, dp::epoch_unit::microseconds,
+			  dp::epoch_unit::nanoseconds };
+			auto const unit =
+			  units[static_cast<int>( opts.from ) - static_cast<int>( layout::epoch )];
+			if( not dp::details::try_parse_epoch<nanoseconds>( str, unit, count ) ) {
+				return false;
+			}
+			break;
+		}
+		case layout::http: {
+			std::int64_t secs = 0;
+			if( not dp::details::try_parse_http_date<true>( str, secs ) or
+			    secs < INT64_MIN / 1'000'000'000 or secs > INT64_MAX / 1'000'000'000 ) {
+				return false;
+			}
+			count = secs * 1'000'000'000;
+			break;
+		}
+		case layout::clf:
+		case layout::syslog:
+			// These parsers only have throwing forms.  Invalid lines are expected
+			// to be rare
+			try {
+				auto const tp = opts.from == layout::clf
+				                  ? dp::parse_clf_timestamp( str )
+				                  : dp::parse_syslog_timestamp( str, opts.year );
+				count = std::chrono::duration_cast<nanoseconds>( tp.time_since_epoch( ) )
+				          .count( );
+			} catch( ... ) {
+				return false;
+			}
+			break;
+		}
+		result = ns_time_t( nanoseconds( count ) );
+		return true;
+	}
+
+	constexpr std::int64_t pow10( int const exp ) noexcept {
+		std::int64_t result = 1;
+		for( int n = 0; n < exp; ++n ) {
+			result *= 10;
+		}
+		return result;
+	}
+
+	// Write tp to out, which has room for 40 characters
+	// @return the number of characters written
+	std::size_t format_field( ns_time_t const tp, rewrite_options const &opts,
+	                          char *out ) {
+		namespace df = daw::date_formatting;
+		auto const ns = tp.time_since_epoch( ).count( );
+		switch( opts.to ) {
+		case layout::javascript:
+			df::fmt_javascript_timestamp( tp, out );
+			return df::javascript_timestamp_size;
+		case layout::http:
+			df::fmt_http_date( tp, out );
+			return daw::date_parsing::http_date_size;
+		case layout::epoch:
+		case layout::epoch_ms:
+		case layout::epoch_s:
+		case layout::epoch_us:
+		case layout::epoch_ns: {
+			auto const digits_dropped = opts.to == layout::epoch_s    ? 9
+			                            : opts.to == layout::epoch_us ? 3
+			                            : opts.to == layout::epoch_ns ? 0
+			                                                          : 6;
+			auto const scale = pow10( digits_dropped );
+			// Round down, as std::chrono::floor does
+			auto value = ns / scale;
+			if( ns % scale < 0 ) {
+				--value;
+			}
+			return static_cast<std::size_t>( std::to_chars( out, out + 40, value ).ptr -
+			                                  out );
+		}
+		default: {
+			auto secs = ns / 1'000'000'000;
+			auto frac = ns % 1'000'000'000;
+			if( frac < 0 ) {
+				frac += 1'000'000'000;
+				--secs;
+			}
+			df::impl::put_date_time( out, secs );
+			std::size_t size = 19;
+			auto const precision = opts.precision < 0 ? 3 : opts.precision;
+			if( precision > 0 ) {
+				out[size++] = '.';
+				auto digits = frac / pow10( 9 - precision );
+				for( auto n = precision; n > 0; --n ) {
+					out[size + static_cast<std::size_t>( n - 1 )] =
+					  static_cast<char>( '0' + digits % 10 );
+					digits /= 10;
+				}
+				size += static_cast<std::size_t>( precision );
+			}
+			out[size++] = 'Z';
+			return size;
+		}
+		}
+	}
+
+	struct chunk_result {
+		std::string text{ };
+		std::size_t rewritten = 0;
+		std::size_t skipped = 0;
+	};
+
+	void rewrite_chunk( daw::string_view in, rewrite_options const &opts,
+	                    chunk_result &result ) {
+		auto &out = result.text;
+		out.clear( );
+		out.reserve( in.size( ) + in.size( ) / 4U + 64U );
+		// ISO 8601 to ISO 8601 keeping the fraction is text to text
+		bool const normalize = opts.from == layout::iso8601 and
+		                       opts.to == layout::iso8601 and opts.precision < 0;
+		while( not in.empty( ) ) {
+			auto const *nl =
+			  static_cast<char const *>( std::memchr( in.data( ), '\n', in.size( ) ) );
+			auto const line_size =
+			  nl == nullptr ? in.size( ) : static_cast<std::size_t>( nl - in.data( ) );
+			auto line = daw::string_view( in.data( ), line_size );
+			if( not line.empty( ) and line.back( ) == '\r' ) {
+				line.remove_suffix( 1 );
+			}
+			std::size_t first = 0;
+			std::size_t last = 0;
+			char buff[64];
+			std::size_t size = 0;
+			if( find_field( line, opts, first, last ) ) {
+				auto const field = daw::string_view( line.data( ) + first, last - first );
+				ns_time_t tp{ };
+				if( normalize ) {
+					size = daw::date_parsing::normalize_iso8601( field, buff );
+				} else if( parse_field( field, opts, tp ) ) {
+					size = format_field( tp, opts, buff );
+				}
+			}
+			if( size > 0 ) {
+				out.append( in.data( ), first );
+				out.append( buff, size );
+				out.append( in.data( ) + last, line_size - last );
+				++result.rewritten;
+			} else {
+				out.append( in.data( ), line_size );
+				++result.skipped;
+			}
+			if( nl == nullptr ) {
+				break;
+			}
+			out.push_back( '\n' );
+			in.remove_prefix( line_size + 1U );
+		}
+	}
+
+	// Split text into pieces of about chunk_size ending at a line end, except
+	// the last
+	std::vector<daw::string_view> split_chunks( daw::string_view text,
+	                                            std::size_t const chunk_size ) {
+		std::vector<daw::string_view> result{ };
+		while( not text.empty( ) ) {
+			if( text.size( ) <= chunk_size ) {
+				result.push_back( text );
+				break;
+			}
+			auto const *nl = static_cast<char const *>( std::memchr(
+			  text.data( ) + chunk_size, '\n', text.size( ) - chunk_size ) );
+			auto const size =
+			  nl == nullptr ? text.size( ) : static_cast<std::size_t>( nl - text.data( ) ) + 1U;
+			result.push_back( daw::string_view( text.data( ), size ) );
+			text.remove_prefix( size );
+		}
+		return result;
+	}
+
+	struct totals {
+		std::size_t rewritten = 0;
+		std::size_t skipped = 0;
+	};
+
+	// The input, and the output, held at once is at most this, or one chunk
+	// when a chunk is larger
+	constexpr std::size_t max_window_size = 256U * 1024U * 1024U;
+
+	// Chunks rewritten at a time, 4 per thread so that the threads stay busy
+	// while chunk sizes vary
+	std::size_t window_chunks( rewrite_options const &opts ) noexcept {
+		auto const chunks = std::min( opts.threads * 4U,
+		                              max_window_size / opts.chunk_size );
+		return std::max( chunks, std::size_t{ 1 } );
+	}
+
+	// Rewrite the chunks on the worker threads and write them in order
+	void rewrite_chunks( std::vector<daw::string_view> const &chunks,
+	                     rewrite_options const &opts,
+	                     std::vector<chunk_result> &results, totals &total ) {
+		if( results.size( ) < chunks.size( ) ) {
+			results.resize( chunks.size( ) );
+		}
+		auto next = std::atomic<std::size_t>( 0 );
+		auto const work = [&] {
+			for( auto n = next++; n < chunks.size( ); n = next++ ) {
+				results[n].rewritten = 0;
+				results[n].skipped = 0;
+				rewrite_chunk( chunks[n], opts, results[n] );
+			}
+		};
+		auto const thread_count = std::min( opts.threads, chunks.size( ) );
+		std::vector<std::thread> threads{ };
+		for( std::size_t n = 1; n < thread_count; ++n ) {
+			threads.emplace_back( work );
+		}
+		work( );
+		for( auto &t : threads ) {
+			t.join( );
+		}
+		for( std::size_t n = 0; n < chunks.size( ); ++n ) {
+			std::fwrite( results[n].text.data( ), 1, results[n].text.size( ), stdout );
+			total.rewritten += results[n].rewritten;
+			total.skipped += results[n].skipped;
+		}
+	}
+
+	int rewrite_file( std::string const &path, rewrite_options const &opts ) {
+		daw::filesystem::memory_mapped_file_t<char> file( path );
+		if( not file ) {
+			std::cerr << "Could not open " << path << '\n';
+			return EXIT_FAILURE;
+		}
+		auto const chunks = split_chunks( daw::string_view( file.data( ), file.size( ) ),
+		                                  opts.chunk_size );
+		std::vector<chunk_result> results{ };
+		totals total{ };
+		// A window of chunks at a time bounds the output held in memory
+		auto const window = window_chunks( opts );
+		for( std::size_t n = 0; n < chunks.size( ); n += window ) {
+			auto const last = std::min( n + window, chunks.size( ) );
+			rewrite_chunks( std::vector<daw::string_view>( chunks.begin( ) + n,
+			                                               chunks.begin( ) + last ),
+			                opts, results, total );
+		}
+		std::cerr << "Rewrote " << total.rewritten << " lines, " << total.skipped
+		          << " unchanged\n";
+		return EXIT_SUCCESS;
+	}
+
+	int rewrite_stdin( rewrite_options const &opts ) {
+		// The buffer starts at a chunk and doubles while the input fills it, so
+		// a short input does not allocate the whole window
+		auto const window_size = window_chunks( opts ) * opts.chunk_size;
+		std::vector<char> buffer( opts.chunk_size );
+		std::vector<chunk_result> results{ };
+		totals total{ };
+		std::size_t carried = 0;
+		while( true ) {
+			auto const space = buffer.size( ) - carried;
+			auto const count = std::fread( buffer.data( ) + carried, 1, space, stdin );
+			auto const size = carried + count;
+			bool const at_end = count == 0 or std::feof( stdin );
+			// Only whole lines are rewritten until the end of the input
+			auto used = size;
+			if( not at_end ) {
+				auto const *first = buffer.data( );
+				auto const *last = first + size;
+				while( last != first and last[-1] != '\n' ) {
+					--last;
+				}
+				used = static_cast<std::size_t>( last - first );
+				if( used == 0 ) {
+					// A line longer than the buffer
+					buffer.resize( buffer.size( ) * 2U );
+					carried = size;
+					continue;
+				}
+			}
+			rewrite_chunks(
+			  split_chunks( daw::string_view( buffer.data( ), used ), opts.chunk_size ),
+			  opts, results, total );
+			carried = size - used;
+			std::memmove( buffer.data( ), buffer.data( ) + used, carried );
+			if( at_end ) {
+				break;
+			}
+			if( count == space and buffer.size( ) < window_size ) {
+				buffer.resize( std::min( buffer.size( ) * 2U, window_size ) );
+			}
+		}
+		std::cerr << "Rewrote " << total.rewritten << " lines, " << total.skipped
+		          << " unchanged\n";
+		return EXIT_SUCCESS;
+	}
+} // namespace
+
+int main( int argc, char **argv ) {
+	auto opts = rewrite_options{ };
+	std::string path{ };
+	for( int n = 1; n < argc; ++n ) {
+		auto const arg = daw::string_view( argv[n] );
+		bool const has_value = n + 1 < argc;
+		auto const number = [&] {
+			return static_cast<std::size_t>( std::strtoull( argv[++n], nullptr, 10 ) );
+		};
+		if( arg == "--from" and has_value ) {
+			if( not parse_layout( daw::string_view( argv[++n] ), opts.from ) ) {
+				return usage( );
+			}
+		} else if( arg == "--to" and has_value ) {
+			if( not parse_layout( daw::string_view( argv[++n] ), opts.to ) or
+			    opts.to == layout::clf or opts.to == layout::syslog ) {
+				return usage( );
+			}
+		} else if( arg == "--precision" and has_value ) {
+			opts.precision = static_cast<int>( number( ) );
+			if( opts.precision > 9 ) {
+				return usage( );
+			}
+		} else if( arg == "--column" and has_value ) {
+			opts.column = number( );
+		} else if( arg == "--offset" and has_value ) {
+			opts.offset = number( );
+			opts.use_offset = true;
+		} else if( arg == "--year" and has_value ) {
+			opts.year = static_cast<std::int32_t>( std::strtol( argv[++n], nullptr, 10 ) );
+		} else if( arg == "--threads" and has_value ) {
+			opts.threads = number( );
+		} else if( arg == "--chunk-size" and has_value ) {
+			opts.chunk_size = number( );
+		} else if( path.empty( ) and ( arg == "-" or arg.empty( ) or arg[0] != '-' ) ) {
+			path = std::string( argv[n] );
+		} else {
+			return usage( );
+		}
+	}
+	if( opts.threads == 0 ) {
+		opts.threads = std::max( 1U, std::thread::hardware_concurrency( ) );
+	}
+	if( opts.chunk_size == 0 ) {
+		return usage( );
+	}
+	std::ios::sync_with_stdio( false );
+	if( path.empty( ) or path == "-" ) {
+		return rewrite_stdin( opts );
+	}
+	return rewrite_file( path, opts );
+}